@@ -0,0 +1,146 @@
+/*
+ * adcDma.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Module captures altitude samples with the uDMA in ping-pong mode.
+ *      The primary control structure fills pingBlock and the alternate pongBlock; as one
+ *      finishes the uDMA carries straight on into the other, so the handler has a whole
+ *      block's time to empty it and set it up again. A handler held off for that long
+ *      finds both stopped and the channel disabled, which loses the samples until it is
+ *      enabled again and is counted as an overrun.
+ */
+
+#include "adcDma.h"
+#include "profiler.h"
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+// The uDMA needs its control table on a UDMA_TABLE_ALIGN byte boundary
+#if defined(__TI_COMPILER_VERSION__)
+#pragma DATA_ALIGN(dmaControlTable, 1024)     // UDMA_TABLE_ALIGN, as a literal for the pragma
+static tDMAControlTable dmaControlTable[UDMA_TABLE_ENTRIES];
+#else
+static tDMAControlTable dmaControlTable[UDMA_TABLE_ENTRIES]
+    __attribute__((aligned(UDMA_TABLE_ALIGN)));
+#endif
+STATIC_ASSERT(__alignof__(dmaControlTable) >= UDMA_TABLE_ALIGN, dma_control_table_aligned);
+static uint16_t pingBlock[ADC_DMA_BLOCK];
+static uint16_t pongBlock[ADC_DMA_BLOCK];
+static bool nextAlternate;          // The block that fills next is pongBlock
+static uint32_t blocks;
+static uint32_t overruns;
+
+//*******************************************************************************************
+// @param select UDMA_PRI_SELECT or UDMA_ALT_SELECT
+//
+// @param block The block the structure fills
+//*******************************************************************************************
+static void
+armBlock(uint32_t select, uint16_t *block)
+{
+    uDMAChannelTransferSet(ADC_DMA_CHANNEL | select, UDMA_MODE_PINGPONG,
+                           (void *)ADC_DMA_FIFO, block, ADC_DMA_BLOCK);
+}
+
+//*******************************************************************************************
+// @param alternate True for pongBlock, false for pingBlock
+//
+// @return bool False if the block is still filling
+//*******************************************************************************************
+static bool
+takeBlock(bool alternate)
+{
+    uint32_t select = alternate ? UDMA_ALT_SELECT : UDMA_PRI_SELECT;
+    uint32_t otherSelect = alternate ? UDMA_PRI_SELECT : UDMA_ALT_SELECT;
+    uint16_t *block = alternate ? pongBlock : pingBlock;
+
+    if (uDMAChannelModeGet(ADC_DMA_CHANNEL | select) != UDMA_MODE_STOP) {
+        return false;
+    }
+    // Samples since went on into the other block, which reads 0 left once it is full
+    writeAdcBlock(block, ADC_DMA_BLOCK, ADC_DMA_DECIMATION,
+                  ADC_DMA_BLOCK - uDMAChannelSizeGet(ADC_DMA_CHANNEL | otherSelect));
+    armBlock(select, block);
+    blocks++;
+    return true;
+}
+
+//*******************************************************************************************
+// Sets up the uDMA, the timer triggered sequence and the block interrupt. Call from
+// initADC() with interrupts masked, after the ADC is enabled and before startADC() starts
+// the sample timer.
+//*******************************************************************************************
+void
+initAdcDma(void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    uDMAEnable();
+    uDMAControlBaseSet(dmaControlTable);
+
+    //
+    // One 16 bit result per request from the sequence FIFO, into consecutive samples
+    uDMAChannelAttributeDisable(ADC_DMA_CHANNEL, UDMA_ATTR_ALL);
+    uDMAChannelControlSet(ADC_DMA_CHANNEL | UDMA_PRI_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+    uDMAChannelControlSet(ADC_DMA_CHANNEL | UDMA_ALT_SELECT,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_NONE | UDMA_DST_INC_16 | UDMA_ARB_1);
+    armBlock(UDMA_PRI_SELECT, pingBlock);
+    armBlock(UDMA_ALT_SELECT, pongBlock);
+    nextAlternate = false;
+    uDMAChannelEnable(ADC_DMA_CHANNEL);
+
+    //
+    // A single step per trigger, which requests the uDMA once converted. Only the
+    // end of a block interrupts, not each sample.
+    ADCSequenceConfigure(ADC0_BASE, ADC_DMA_SEQUENCE, ADC_TRIGGER_TIMER, 0);
+    ADCSequenceStepConfigure(ADC0_BASE, ADC_DMA_SEQUENCE, 0, ADC_ALTITUDE_CHANNEL |
+                             ADC_CTL_IE | ADC_CTL_END);
+    ADCSequenceDMAEnable(ADC0_BASE, ADC_DMA_SEQUENCE);
+    ADCSequenceEnable(ADC0_BASE, ADC_DMA_SEQUENCE);
+    ADCIntRegister(ADC0_BASE, ADC_DMA_SEQUENCE, ADCDmaIntHandler);
+    ADCIntEnableEx(ADC0_BASE, ADC_DMA_INT_FLAG);
+
+}
+
+//*******************************************************************************************
+// Hands each full block to the altitude buffer and sets it up to be filled again
+//*******************************************************************************************
+void
+ADCDmaIntHandler(void)
+{
+    uint32_t startCycles = isrEnter(ISR_ADC, ISR_LATENCY_UNKNOWN);
+
+    ADCIntClearEx(ADC0_BASE, ADC_DMA_INT_FLAG);
+    // Oldest first. Both are full if the handler was held off for a whole block.
+    if (takeBlock(nextAlternate)) {
+        nextAlternate = !nextAlternate;
+        if (takeBlock(nextAlternate)) {
+            nextAlternate = !nextAlternate;
+        }
+    }
+    // The uDMA disables the channel when it finds both blocks full
+    if (!uDMAChannelIsEnabled(ADC_DMA_CHANNEL)) {
+        overruns++;
+        uDMAChannelEnable(ADC_DMA_CHANNEL);
+    }
+    isrExit(ISR_ADC, startCycles);
+}
+
+//*******************************************************************************************
+// @return uint32_t Blocks handed to the altitude buffer since initAdcDma()
+//*******************************************************************************************
+uint32_t
+getAdcDmaBlocks(void)
+{
+    return blocks;
+}
+
+//*******************************************************************************************
+// @return uint32_t Times both blocks filled before the handler emptied one, losing samples
+//*******************************************************************************************
+uint32_t
+getAdcDmaOverruns(void)
+{
+    return overruns;
+}
@@ -0,0 +1,72 @@
+/*
+ * adcDma.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the uDMA altitude capture, the ADC_MODE_DMA way of
+ *      sampling the altitude. The sample timer triggers ADC0 sequence 3 at
+ *      ADC_DMA_RATE_HZ with no processor involvement, and the uDMA moves each result into
+ *      one of two blocks in turn. The processor is interrupted once per full block, which it hands to the
+ *      altitude buffer while the uDMA fills the other.
+ */
+
+#ifndef ADCDMA_H_
+#define ADCDMA_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_adc.h"
+#include "inc/hw_ints.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/adc.h"
+#include "driverlib/udma.h"
+#include "altitude.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+// Samples each second, a multiple of SAMPLE_RATE_HZ. Each buffer sample is the mean of
+// ADC_DMA_DECIMATION of them, so the altitude filter keeps its rate and window.
+#define ADC_DMA_RATE_HZ 1500
+#define ADC_DMA_DECIMATION (ADC_DMA_RATE_HZ / SAMPLE_RATE_HZ)
+// Samples in each half of the ping-pong, a multiple of ADC_DMA_DECIMATION. The block
+// interrupt runs at ADC_DMA_RATE_HZ / ADC_DMA_BLOCK.
+#define ADC_DMA_BLOCK 30
+#define ADC_DMA_SEQUENCE 3
+#define ADC_DMA_INT INT_ADC0SS3
+#define ADC_DMA_INT_FLAG ADC_INT_DMA_SS3
+#define ADC_DMA_FIFO (ADC0_BASE + ADC_O_SSFIFO3)
+#define ADC_DMA_CHANNEL UDMA_CHANNEL_ADC3
+#define UDMA_TABLE_ENTRIES 64   // Primary and alternate structures for 32 channels
+#define UDMA_TABLE_ALIGN 1024   // Boundary the control table must start on
+
+//*******************************************************************************************
+// Sets up the uDMA, the timer triggered sequence and the block interrupt. Call from
+// initADC() with interrupts masked, after the ADC is enabled and before startADC() starts
+// the sample timer.
+//*******************************************************************************************
+void
+initAdcDma(void);
+
+//*******************************************************************************************
+// Hands each full block to the altitude buffer and sets it up to be filled again
+//*******************************************************************************************
+void
+ADCDmaIntHandler(void);
+
+//*******************************************************************************************
+// @return uint32_t Blocks handed to the altitude buffer since initAdcDma()
+//*******************************************************************************************
+uint32_t
+getAdcDmaBlocks(void);
+
+//*******************************************************************************************
+// @return uint32_t Times both blocks filled before the handler emptied one, losing samples
+//*******************************************************************************************
+uint32_t
+getAdcDmaOverruns(void);
+
+#endif /* ADCDMA_H_ */
@@ -10,67 +10,322 @@
  */
 
 #include "altitude.h"
+#include "adcDma.h"
+#include "hardTier.h"
 
 //*****************************************************************************
 // Global variables
 //*****************************************************************************
-static int32_t setAltitude;
+static volatile int32_t setAltitude;   // Written from the background, read by the hard tier
 static int32_t currentAdc;
 static int32_t initialAdc = 0;
 static int32_t currentAltitude;
-static circBuf_t g_inBuffer;        // Buffer of size BUF_SIZE integers (sample values)
+static filter_t altitudeFilters[2];        // The running filter and a spare to set up
+static filter_t *volatile altitudeFilter = &altitudeFilters[0];    // Filter each sample goes through
+static volatile uint32_t filterDelayUs;    // Delay of altitudeFilter
+static uint32_t blockSamples;       // Samples written since the last EVENT_ADC_BLOCK
+static uint32_t eventSamples;       // Samples written since the last EVENT_ADC_SAMPLES
+static volatile uint32_t samplesPerEvent = ADC_EVENT_SAMPLES;
+static uint32_t oversample = ADC_OVERSAMPLE;
+static uint32_t sampleLoad;         // Sample timer load, one less than its period in cycles
+static volatile uint64_t newestSampleUs;   // Time the newest sample was taken
+
+// The coefficients each filter starts with when it is selected by type alone
+static const filterConfig_t filterPresets[NUM_FILTER_TYPES] = {
+    [FILTER_BOXCAR] = { FILTER_BOXCAR, { BUF_SIZE } },
+    [FILTER_IIR1] = { FILTER_IIR1, { ALTITUDE_IIR1_ALPHA } },
+    [FILTER_IIR2] = { FILTER_IIR2, { ALTITUDE_IIR2_COEFFICIENTS } },
+    [FILTER_CIC] = { FILTER_CIC, { ALTITUDE_CIC_DECIMATION, ALTITUDE_CIC_ORDER } },
+    [FILTER_MEDIAN] = { FILTER_MEDIAN, { ALTITUDE_MEDIAN_WIDTH } },
+};
 
 //*****************************************************************************
 // Reads the values from the adc on Tiva Board to get Helicopter altitude
 //
-// @return The sampled and averaged adc reading from a circular buffer
+// @return The sampled adc reading, after the altitude filter
+//
+// The ADC handler runs the filter as each sample comes in, so this takes the same
+// time for any filter and any number of callers.
 //*****************************************************************************
 int32_t
 getAdcOutput(void)
 {
-    int32_t sum = 0;
-    size_t i;
-    for (i = 0; i < BUF_SIZE; i++)
-    {
-        sum = sum + readCircBuf (&g_inBuffer);
+    // A single word, so a handler never leaves it half written
+    return altitudeFilter->output;
+}
+
+//*****************************************************************************
+// @param delayQ A filter delay from getFilterDelay()
+//
+// @return uint32_t The delay in microseconds at SAMPLE_RATE_HZ
+//*****************************************************************************
+static uint32_t
+filterDelayToUs(int32_t delayQ)
+{
+    return ((uint64_t)delayQ * TIME_US_PER_SECOND / SAMPLE_RATE_HZ) >> FILTER_DELAY_Q_BITS;
+}
+
+//*****************************************************************************
+// @param config The filter for the altitude samples and its coefficients
+//
+// @return bool False if the coefficients are not valid, leaving the one running unchanged
+//
+// The new filter starts from the current output, so the altitude does not jump.
+// Call from the background, not a handler.
+//*****************************************************************************
+bool
+setAltitudeFilter(const filterConfig_t *config)
+{
+    filter_t *spare = (altitudeFilter == &altitudeFilters[0]) ? &altitudeFilters[1]
+                                                              : &altitudeFilters[0];
+    bool wasUnlocked;
+
+    // The ADC handler only runs the filter altitudeFilter points to, so the spare can be
+    // set up in place while it runs, and a single word write hands it over
+    if (!initFilter(spare, config, getAdcOutput())) {
+        return false;
     }
-    // Calculate and display the rounded mean of the buffer contents
-    return (2 * sum + BUF_SIZE) / 2 / BUF_SIZE;
+    // The hard tier reads the output and its delay together for the sensor snapshot
+    wasUnlocked = lockHardTier();
+    altitudeFilter = spare;
+    filterDelayUs = filterDelayToUs(getFilterDelay(config));
+    unlockHardTier(wasUnlocked);
+    return true;
+}
+
+//*****************************************************************************
+// @param config Filled with the filter running and its coefficients
+//*****************************************************************************
+void
+getAltitudeFilter(filterConfig_t *config)
+{
+    *config = altitudeFilter->config;
+}
+
+//*****************************************************************************
+// @param type A filter
+//
+// @param config Filled with that filter and the coefficients it starts with here
+//*****************************************************************************
+void
+getAltitudeFilterPreset(filterType_t type, filterConfig_t *config)
+{
+    *config = filterPresets[type < NUM_FILTER_TYPES ? type : ALTITUDE_FILTER];
+}
+
+//*****************************************************************************
+// @return uint32_t Time a slowly changing altitude takes to pass through the filter
+//*****************************************************************************
+uint32_t
+getAltitudeFilterDelayUs(void)
+{
+    return filterDelayUs;
+}
+
+//*****************************************************************************
+// @return uint64_t getTimeUs() time of the input getAdcOutput() currently shows,
+// the newest sample less the filter's delay
+//*****************************************************************************
+uint64_t
+getAdcOutputTimeUs(void)
+{
+    return getAdcSampleTimeUs(0) - filterDelayUs;
 }
 
 //*****************************************************************************
 // Finds the error between the desired and the actual altitude of the heli
 //
-// @return int32_t The sampled and averaged adc reading from a circular buffer
+// @param altitude The actual altitude, as processAltitude() gives
+//
+// @return int32_t The desired altitude less the actual
 //*****************************************************************************
 int32_t
-getAltitudeError(void) {
-    // Process altitude gets the most up to date adc reading as an altitude
-    currentAltitude = processAltitude();
+getAltitudeError(int32_t altitude) {
+    currentAltitude = altitude;
     return setAltitude - currentAltitude;
 }
 
+//*****************************************************************************
+// @param samples Samples between each EVENT_ADC_SAMPLES, ADC_EVENT_SAMPLES at boot
+//*****************************************************************************
+void
+setAdcEventSamples(uint32_t samples)
+{
+    samplesPerEvent = samples > 0 ? samples : 1;
+}
+
+//*****************************************************************************
+// @param age Samples older than the newest, 0 for the newest
+//
+// @return uint64_t getTimeUs() time the sample was taken. For the time of the input
+// getAdcOutput() shows, allowing for the filter, see getAdcOutputTimeUs() and
+// getAltitudeFilterDelayUs().
+//
+// The timer spaces the samples exactly 1 / SAMPLE_RATE_HZ apart, so only the newest
+// is stamped and the others follow from it.
+//*****************************************************************************
+uint64_t
+getAdcSampleTimeUs(uint32_t age)
+{
+    uint64_t newestUs;
+    bool wasDisabled = IntMasterDisable();
+
+    // Two words, so keep the handler from writing it between them
+    newestUs = newestSampleUs;
+    if (!wasDisabled) {
+        IntMasterEnable();
+    }
+    return newestUs - (uint64_t)age * TIME_US_PER_SECOND / SAMPLE_RATE_HZ;
+}
+
+//*****************************************************************************
+// @param triggerCycles Set to the getTimeCycles() time of the last sample timer trigger
+//
+// @return uint32_t Cycles since that trigger
+//
+// The timer reloads as it triggers the ADC and counts down from its load value, so
+// the count gives the time of the trigger exactly, however late the handler runs.
+//*****************************************************************************
+static uint32_t
+sampleTriggered(uint64_t *triggerCycles)
+{
+    uint64_t nowCycles;
+    uint32_t sinceCycles;
+    bool wasDisabled = IntMasterDisable();
+
+    // Read together, so nothing runs between them to skew one against the other
+    nowCycles = getTimeCycles();
+    sinceCycles = sampleLoad - TimerValueGet(ADC_TIMER_BASE, TIMER_A);
+    if (!wasDisabled) {
+        IntMasterEnable();
+    }
+    *triggerCycles = nowCycles - sinceCycles;
+    return sinceCycles;
+}
+
+//*****************************************************************************
+// @param value A new sample, for the altitude filter
+//
+// @param sampleCycles getTimeCycles() time the sample was taken
+//
+// Posts an EVENT_ADC_BLOCK every BUF_SIZE samples and an EVENT_ADC_SAMPLES
+// every samplesPerEvent samples. Called from the handler of whichever acquisition
+// mode is running.
+//*****************************************************************************
+static void
+addSample(uint32_t value, uint64_t sampleCycles)
+{
+    runFilter(altitudeFilter, value);
+    newestSampleUs = timeCyclesToUs(sampleCycles);
+    blockSamples++;
+    if (blockSamples >= BUF_SIZE) {
+        blockSamples = 0;
+        postEvent(EVENT_ADC_BLOCK, 0, value);
+    }
+    eventSamples++;
+    if (eventSamples >= samplesPerEvent) {
+        eventSamples = 0;
+        postEvent(EVENT_ADC_SAMPLES, 0, value);
+    }
+}
+
+//*****************************************************************************
+// @param conversions Samples the uDMA captured, oldest first
+//
+// @param count Number of samples, a multiple of perSample
+//
+// @param perSample Samples averaged into each buffer sample
+//
+// @param newer Samples the uDMA has captured since the last of these, to time them
+//
+// Called by the ADC_MODE_DMA block handler. Each buffer sample is stamped with the
+// middle of the samples it averages, counted back from the last trigger. Samples lost
+// to an overrun are not counted, so the stamps after one are only approximate.
+//*****************************************************************************
+void
+writeAdcBlock(const uint16_t *conversions, uint32_t count, uint32_t perSample,
+              uint32_t newer)
+{
+    uint64_t triggerCycles;
+    uint64_t backCycles;
+    uint32_t sum;
+    uint32_t i;
+    uint32_t j;
+
+    sampleTriggered(&triggerCycles);
+    for (i = 0; i + perSample <= count; i += perSample) {
+        sum = 0;
+        for (j = 0; j < perSample; j++) {
+            sum += conversions[i + j];
+        }
+        // Half periods back from the last trigger to the middle of this group
+        backCycles = (uint64_t)(2 * (newer + count - 1 - i) - (perSample - 1))
+                     * (sampleLoad + 1) / 2;
+        addSample((sum + perSample / 2) / perSample,
+                  backCycles < triggerCycles ? triggerCycles - backCycles : 0);
+    }
+}
+
+//*****************************************************************************
+// @param factor Conversions the hardware averages into each step, 1 to turn the
+// averager off or a power of two up to ADC_MAX_OVERSAMPLE
+//
+// @return bool False if the factor is not one of those, leaving it unchanged
+//*****************************************************************************
+bool
+setAdcOversample(uint32_t factor)
+{
+    if (factor == 0 || factor > ADC_MAX_OVERSAMPLE || (factor & (factor - 1)) != 0) {
+        return false;
+    }
+    // A burst converting now may average some steps at the old factor, still a mean
+    ADCHardwareOversampleConfigure(ADC0_BASE, factor);
+    oversample = factor;
+    return true;
+}
+
+//*****************************************************************************
+// @return uint32_t Conversions averaged into each step
+//*****************************************************************************
+uint32_t
+getAdcOversample(void)
+{
+    return oversample;
+}
+
 //*****************************************************************************
 //
-// The handler for the ADC conversion complete interrupt.
-// Writes to the circular buffer.
+// The handler for the ADC conversion complete interrupt in ADC_MODE_BURST.
+// Passes the mean of the burst to the altitude filter.
 //
 //*****************************************************************************
 void
 ADCIntHandler(void)
 {
-    uint32_t ulValue;
+    uint32_t steps[ADC_MAX_STEPS];
+    uint32_t ulValue = 0;
+    int32_t count;
+    int32_t i;
+    uint64_t triggerCycles;
+    uint32_t startCycles = isrEnter(ISR_ADC, sampleTriggered(&triggerCycles));
 
     //
-    // Get the single sample from ADC0.  ADC_BASE is defined in
-    // inc/hw_memmap.h
-    ADCSequenceDataGet(ADC0_BASE, 3, &ulValue);
-    //
-    // Place it in the circular buffer (advancing write index)
-    writeCircBuf (&g_inBuffer, ulValue);
+    // Get the burst from ADC0, each step already averaged by the hardware.
+    // ADC_BASE is defined in inc/hw_memmap.h
+    count = ADCSequenceDataGet(ADC0_BASE, ADC_SEQUENCE, steps);
+    if (count <= 0) {
+        ADCIntClear(ADC0_BASE, ADC_SEQUENCE);
+        isrExit(ISR_ADC, startCycles);
+        return;
+    }
+    for (i = 0; i < count; i++) {
+        ulValue += steps[i];
+    }
+    addSample((ulValue + count / 2) / count, triggerCycles);
     //
     // Clean up, clearing the interrupt
-    ADCIntClear(ADC0_BASE, 3);
+    ADCIntClear(ADC0_BASE, ADC_SEQUENCE);
+    isrExit(ISR_ADC, startCycles);
 }
 
 //*****************************************************************************
@@ -81,56 +336,94 @@ ADCIntHandler(void)
 void
 SysTickIntHandler(void)
 {
-    // Polls buttons, scheduler, adc and switches every system tick
-    ADCProcessorTrigger(ADC0_BASE, 3);
+    // The counter reloaded when the interrupt was raised, so its count since is the latency
+    uint32_t startCycles = isrEnter(ISR_SYSTICK, SysTickPeriodGet() - 1 - SysTickValueGet());
+
+    // Polls buttons, scheduler and switches every system tick. Button and switch
+    // changes are posted as events for the main loop. The ADC has its own timer.
     updateButtons();
     updateSwitches();
     updateScheduleTicks();
-    checkResetSwitch();
+    isrExit(ISR_SYSTICK, startCycles);
 }
 
 //*****************************************************************************
 //
-// Initialises the ADC interrupt to read voltages, corresponding to different altitudes
+// Initialises the ADC interrupt to read voltages, corresponding to different altitudes,
+// in the acquisition mode ADC_MODE selects. The samples start with startADC().
 //
 //*****************************************************************************
 void
 initADC (void)
 {
+    uint32_t step;
+
+    // Starts from 0, as if every sample so far had been 0
+    initFilter(altitudeFilter, &filterPresets[ALTITUDE_FILTER], 0);
+    filterDelayUs = filterDelayToUs(getFilterDelay(&filterPresets[ALTITUDE_FILTER]));
+
     //
     // The ADC0 peripheral must be enabled for configuration and use.
     SysCtlPeripheralEnable(SYSCTL_PERIPH_ADC0);
 
-    // Enable sample sequence 3 with a processor signal trigger.  Sequence 3
-    // will do a single sample when the processor sends a signal to start the
-    // conversion.
-    ADCSequenceConfigure(ADC0_BASE, 3, ADC_TRIGGER_PROCESSOR, 0);
+    //
+    // Average each conversion in hardware, taking the noise out before the interrupt
+    ADCHardwareOversampleConfigure(ADC0_BASE, oversample);
+
+    //
+    // The sample timer's trigger output starts each conversion, a single sample in
+    // ADC_MODE_DMA and a burst otherwise
+    SysCtlPeripheralEnable(ADC_TIMER_PERIPH);
+    TimerConfigure(ADC_TIMER_BASE, TIMER_CFG_PERIODIC);
+    sampleLoad = SysCtlClockGet() / (ADC_MODE == ADC_MODE_DMA ? ADC_DMA_RATE_HZ
+                                                              : SAMPLE_RATE_HZ) - 1;
+    TimerLoadSet(ADC_TIMER_BASE, TIMER_A, sampleLoad);
+    TimerControlTrigger(ADC_TIMER_BASE, TIMER_A, true);
+
+    if (ADC_MODE == ADC_MODE_DMA) {
+        initAdcDma();
+        return;
+    }
+
+    // Enable the altitude sequence with a timer trigger. The sequence samples
+    // ADC_BURST_STEPS times each time the sample timer reloads.
+    ADCSequenceConfigure(ADC0_BASE, ADC_SEQUENCE, ADC_TRIGGER_TIMER, 0);
 
     //
-    // Configure step 0 on sequence 3.  Sample channel 0 (ADC_CTL_CH0) in
-    // single-ended mode (default) and configure the interrupt flag
-    // (ADC_CTL_IE) to be set when the sample is done.  Tell the ADC logic
-    // that this is the last conversion on sequence 3 (ADC_CTL_END).  Sequence
-    // 3 has only one programmable step.  Sequence 1 and 2 have 4 steps, and
-    // sequence 0 has 8 programmable steps.  Since we are only doing a single
-    // conversion using sequence 3 we will only configure step 0.  For more
-    // on the ADC sequences and steps, refer to the LM3S1968 datasheet.
-    ADCSequenceStepConfigure(ADC0_BASE, 3, 0, ADC_CTL_CH9 | ADC_CTL_IE |
-                             ADC_CTL_END);
+    // Configure each step to sample channel 9 in single-ended mode (default). The
+    // last step sets the interrupt flag (ADC_CTL_IE) when the burst is done, and is
+    // the last conversion on the sequence (ADC_CTL_END). Sequence 3 has only one
+    // programmable step, sequences 1 and 2 have 4 steps, and sequence 0 has 8, so
+    // ADC_SEQUENCE is the shortest that holds the burst.
+    for (step = 0; step < ADC_BURST_STEPS - 1; step++) {
+        ADCSequenceStepConfigure(ADC0_BASE, ADC_SEQUENCE, step, ADC_ALTITUDE_CHANNEL);
+    }
+    ADCSequenceStepConfigure(ADC0_BASE, ADC_SEQUENCE, step, ADC_ALTITUDE_CHANNEL |
+                             ADC_CTL_IE | ADC_CTL_END);
 
     //
-    // Since sample sequence 3 is now configured, it must be enabled.
-    ADCSequenceEnable(ADC0_BASE, 3);
+    // Since the sequence is now configured, it must be enabled.
+    ADCSequenceEnable(ADC0_BASE, ADC_SEQUENCE);
 
     //
     // Register the interrupt handler
-    ADCIntRegister (ADC0_BASE, 3, ADCIntHandler);
+    ADCIntRegister (ADC0_BASE, ADC_SEQUENCE, ADCIntHandler);
 
     //
-    // Enable interrupts for ADC0 sequence 3 (clears any outstanding interrupts)
-    ADCIntEnable(ADC0_BASE, 3);
+    // Enable interrupts for the sequence (clears any outstanding interrupts)
+    ADCIntEnable(ADC0_BASE, ADC_SEQUENCE);
+}
 
-    initCircBuf (&g_inBuffer, BUF_SIZE);
+//*****************************************************************************
+//
+// Starts the sample timer, and with it the samples. Call just before interrupts are
+// enabled, so no sample or uDMA block is waiting on a handler that cannot run yet.
+//
+//*****************************************************************************
+void
+startADC (void)
+{
+    TimerEnable(ADC_TIMER_BASE, TIMER_A);
 }
 
 //*****************************************************************************
@@ -144,42 +437,41 @@ void initialiseAdcValue(void) {
 }
 
 //*****************************************************************************
-// @param adcOutput The averaged output from the adc module, read from circular buffer
+// @param adcOutput The filtered output from the adc module
 //
 // @param initialAdc The first adc reading, indicated where the helicopter's initial position is
 //
-// @return int32_t The percentage altitude of the helicopters position
+// @return int32_t The percentage altitude of the helicopters position, truncated toward 0
 //
-// Initialises the ADC interrupt to read voltages, corresponding to different altitudes
+// Converts in integer arithmetic only, giving the same result as the floating point
+// conversion it replaced for every pair of 12 bit readings (checked by host/heliConvert)
 //
 //*****************************************************************************
 int32_t
-percentageCalculator(int32_t adcOutput, double initialAdc)
+percentageCalculator(int32_t adcOutput, int32_t initialAdc)
 {
-    // Converts initial and current adc to a percentage
-    double scaledInitial = initialAdc * PERCENTAGE_CONVERSION;
-    double scaledCurrent = adcOutput * PERCENTAGE_CONVERSION;
-    // Scales both readings by the voltage and divides the number of steps in adc
-    double scaledInitialVoltage = (scaledInitial * MAX_VOLTAGE)/ADC_STEPS;
-    double scaledVoltageOutput = (scaledCurrent * MAX_VOLTAGE)/ADC_STEPS;
-    // Inversely proportional, so returns the negative of the difference between initial and current voltages
-    return -(scaledVoltageOutput-scaledInitialVoltage);
+    // Inversely proportional, so the drop from the initial reading is the altitude.
+    // At most 4095 steps, so the product fits easily, and dividing truncates like the
+    // conversion to int did.
+    return (initialAdc - adcOutput) * ALTITUDE_PER_STEP_Q16 / (1 << ALTITUDE_Q_BITS);
 }
 
 //*****************************************************************************
 // @param int16_t The change in altitude
 //
 // Increases the altitude by a certain change
-//
+// The new setpoint is clamped before it is stored, in a single word write, so the
+// controller in the hard tier never sees it out of bounds.
 //*****************************************************************************
 void updateAltitude(int16_t change) {
-    setAltitude += change;
+    int32_t setpoint = setAltitude + change;
     // Prevents the altitude from going out of bounds
-    if (setAltitude > MAX_ALTITUDE) {
-        setAltitude = MAX_ALTITUDE;
-    } else if (setAltitude < MIN_ALTITUDE) {
-        setAltitude = MIN_ALTITUDE;
+    if (setpoint > MAX_ALTITUDE) {
+        setpoint = MAX_ALTITUDE;
+    } else if (setpoint < MIN_ALTITUDE) {
+        setpoint = MIN_ALTITUDE;
     }
+    setAltitude = setpoint;
 }
 
 
@@ -20,26 +20,79 @@
 #include <stdlib.h>
 #include "inc/hw_memmap.h"
 #include "inc/hw_types.h"
+#include "inc/hw_ints.h"
 #include "driverlib/gpio.h"
 #include "driverlib/adc.h"
 #include "driverlib/sysctl.h"
+#include "driverlib/systick.h"
+#include "driverlib/timer.h"
 #include "circBufT.h"
+#include "filters.h"
 #include "altitude.h"
 #include "states.h"
 #include "switches.h"
 #include "pidController.h"
 #include "scheduler.h"
+#include "profiler.h"
+#include "eventQueue.h"
+#include "timeBase.h"
 
 //*****************************************************************************
 // Constants
 //*****************************************************************************
 
-#define BUF_SIZE 35
+#define BUF_SIZE 35             // Samples between each EVENT_ADC_BLOCK
+#define ADC_EVENT_SAMPLES 10 // Samples between each EVENT_ADC_SAMPLES
+// Buffer samples each second. The sample timer's trigger output starts each conversion
+// with no software in the way, so the rate is independent of SYSTICK_RATE_HZ and the
+// samples are evenly spaced whatever the handlers are doing.
 #define SAMPLE_RATE_HZ 150
+#define ADC_TIMER_PERIPH SYSCTL_PERIPH_TIMER0
+#define ADC_TIMER_BASE TIMER0_BASE
+
+// Altitude acquisition modes. ADC_MODE_BURST triggers a burst at SAMPLE_RATE_HZ and
+// takes an interrupt per sample. ADC_MODE_DMA triggers single conversions at
+// ADC_DMA_RATE_HZ and the uDMA moves them, taking an interrupt per block (adcDma.h).
+// Either way the buffer gets SAMPLE_RATE_HZ samples a second. Can be overridden from
+// the build, e.g. by the host simulator.
+#define ADC_MODE_BURST 0
+#define ADC_MODE_DMA 1
+#ifndef ADC_MODE
+#define ADC_MODE ADC_MODE_BURST
+#endif
+
+// The filter the samples go through at boot (filters.h), and the coefficients each filter
+// starts with when it is selected by type alone. The boxcar is the mean of the last
+// BUF_SIZE samples, smooth but slow, and the others trade some of its smoothing for less
+// delay.
+#define ALTITUDE_FILTER FILTER_BOXCAR
+#define ALTITUDE_IIR1_ALPHA 2048                // 1/8 of each new sample
+#define ALTITUDE_IIR2_COEFFICIENTS 370, 739, 370, -25107, 10202    // Butterworth, 8 Hz
+#define ALTITUDE_CIC_DECIMATION 4
+#define ALTITUDE_CIC_ORDER 3
+#define ALTITUDE_MEDIAN_WIDTH 5
+
+// Each sample timer trigger starts a burst of ADC_BURST_STEPS steps, each the hardware average of
+// the oversampling factor's conversions, and their rounded mean is one buffer sample.
+// One step runs on sequence 3, up to 4 on sequence 1 and up to 8 on sequence 0.
+#define ADC_BURST_STEPS 4
+#define ADC_OVERSAMPLE 8        // Conversions per step at boot, 1 or a power of two
+#define ADC_MAX_OVERSAMPLE 64
+#define ADC_MAX_STEPS 8         // Deepest sequence FIFO
+#define ADC_SEQUENCE (ADC_BURST_STEPS > 4 ? 0 : ADC_BURST_STEPS > 1 ? 1 : 3)
+#define ADC_ALTITUDE_INT (INT_ADC0SS0 + ADC_SEQUENCE)
+#define ADC_ALTITUDE_CHANNEL ADC_CTL_CH9
 #define ADC_STEPS 4096
-#define MAX_VOLTAGE 3.3
+#define MAX_VOLTAGE_MV 3300
+#define MV_PER_VOLT 1000
 #define ALTITUDE_INCREASE 10
 #define PERCENTAGE_CONVERSION 100
+// Altitude percent per ADC step in Q16, 1 % for every 10 mV the sensor drops. The
+// calibration folds into this one constant, 5280 / 65536 of a percent, which is exact,
+// so the conversion is an integer multiply and divide.
+#define ALTITUDE_Q_BITS 16
+#define ALTITUDE_PER_STEP_Q16 ((int32_t)((uint64_t)PERCENTAGE_CONVERSION * MAX_VOLTAGE_MV \
+                                         * (1u << ALTITUDE_Q_BITS) / MV_PER_VOLT / ADC_STEPS))
 #define MAX_ALTITUDE 100
 #define MIN_ALTITUDE 0
 #define HOVER_ALTITUDE 10
@@ -50,22 +103,75 @@
 //*****************************************************************************
 // Reads the values from the adc on Tiva Board to get Helicopter altitude
 //
-// @return The sampled and averaged adc reading from a circular buffer
+// @return The sampled adc reading, after the altitude filter
+//
+// Constant time and changes nothing, so any task or handler may call it.
 //*****************************************************************************
 int32_t
 getAdcOutput(void);
 
+//*****************************************************************************
+// @param config The filter for the altitude samples and its coefficients
+//
+// @return bool False if the coefficients are not valid, leaving the one running unchanged
+//
+// The new filter starts from the current output, so the altitude does not jump.
+// Call from the background, not a handler.
+//*****************************************************************************
+bool
+setAltitudeFilter(const filterConfig_t *config);
+
+//*****************************************************************************
+// @param config Filled with the filter running and its coefficients
+//*****************************************************************************
+void
+getAltitudeFilter(filterConfig_t *config);
+
+//*****************************************************************************
+// @param type A filter
+//
+// @param config Filled with that filter and the coefficients it starts with here
+//*****************************************************************************
+void
+getAltitudeFilterPreset(filterType_t type, filterConfig_t *config);
+
+//*****************************************************************************
+// @return uint32_t Time a slowly changing altitude takes to pass through the filter
+//*****************************************************************************
+uint32_t
+getAltitudeFilterDelayUs(void);
+
+//*****************************************************************************
+// @return uint64_t getTimeUs() time of the input getAdcOutput() currently shows,
+// the newest sample less the filter's delay
+//*****************************************************************************
+uint64_t
+getAdcOutputTimeUs(void);
+
+//*****************************************************************************
+// @param age Samples older than the newest, 0 for the newest
+//
+// @return uint64_t getTimeUs() time the sample was taken
+//
+// The timer spaces the samples exactly 1 / SAMPLE_RATE_HZ apart, so only the newest
+// is stamped and the others follow from it.
+//*****************************************************************************
+uint64_t
+getAdcSampleTimeUs(uint32_t age);
+
 //*****************************************************************************
 // Finds the error between the desired and the actual altitude of the heli
 //
-// @return int32_t The sampled and averaged adc reading from a circular buffer
+// @param altitude The actual altitude, as processAltitude() gives
+//
+// @return int32_t The desired altitude less the actual
 //*****************************************************************************
 int32_t
-getAltitudeError(void);
+getAltitudeError(int32_t altitude);
 
 //*****************************************************************************
 //
-// The interrupt handler for the for SysTick interrupt, for adc module
+// The interrupt handler for the for SysTick interrupt
 //
 //*****************************************************************************
 void
@@ -87,10 +193,46 @@ getInitialAdc(void);
 //*****************************************************************************
 void initialiseAdcValue(void);
 
+//*****************************************************************************
+// @param samples Samples between each EVENT_ADC_SAMPLES, ADC_EVENT_SAMPLES at boot
+//*****************************************************************************
+void
+setAdcEventSamples(uint32_t samples);
+
+//*****************************************************************************
+// @param factor Conversions the hardware averages into each step, 1 to turn the
+// averager off or a power of two up to ADC_MAX_OVERSAMPLE
+//
+// @return bool False if the factor is not one of those, leaving it unchanged
+//*****************************************************************************
+bool
+setAdcOversample(uint32_t factor);
+
+//*****************************************************************************
+// @return uint32_t Conversions averaged into each step
+//*****************************************************************************
+uint32_t
+getAdcOversample(void);
+
+//*****************************************************************************
+// @param conversions Samples the uDMA captured, oldest first
+//
+// @param count Number of samples, a multiple of perSample
+//
+// @param perSample Samples averaged into each buffer sample
+//
+// @param newer Samples the uDMA has captured since the last of these, to time them
+//
+// Called by the ADC_MODE_DMA block handler
+//*****************************************************************************
+void
+writeAdcBlock(const uint16_t *conversions, uint32_t count, uint32_t perSample,
+              uint32_t newer);
+
 //*****************************************************************************
 //
-// The handler for the ADC conversion complete interrupt.
-// Writes to the circular buffer.
+// The handler for the ADC conversion complete interrupt in ADC_MODE_BURST.
+// Passes the mean of the burst to the altitude filter.
 //
 //*****************************************************************************
 void
@@ -98,24 +240,35 @@ ADCIntHandler(void);
 
 //*****************************************************************************
 //
-// Initialises the ADC interrupt to read voltages, corresponding to different altitudes
+// Initialises the ADC interrupt to read voltages, corresponding to different altitudes,
+// in the acquisition mode ADC_MODE selects. The samples start with startADC().
 //
 //*****************************************************************************
 void
 initADC (void);
 
 //*****************************************************************************
-// @param adcOutput The averaged output from the adc module, read from circular buffer
+//
+// Starts the sample timer, and with it the samples. Call just before interrupts are
+// enabled, so no sample or uDMA block is waiting on a handler that cannot run yet.
+//
+//*****************************************************************************
+void
+startADC (void);
+
+//*****************************************************************************
+// @param adcOutput The filtered output from the adc module
 //
 // @param initialAdc The first adc reading, indicated where the helicopter's initial position is
 //
-// @return double The float corresponding to the percentage altitude of the helicopters position
+// @return int32_t The percentage altitude of the helicopters position, truncated toward 0
 //
-// Initialises the ADC interrupt to read voltages, corresponding to different altitudes
+// Converts in integer arithmetic only, giving the same result as the floating point
+// conversion it replaced for every pair of 12 bit readings (checked by host/heliConvert)
 //
 //*****************************************************************************
 int32_t
-percentageCalculator(int32_t adcOutput, double initialAdc);
+percentageCalculator(int32_t adcOutput, int32_t initialAdc);
 
 //*****************************************************************************
 // Set the altitude to the desired percentage. Takes the desired altitude as input
@@ -24,6 +24,7 @@
 #include "driverlib/debug.h"
 #include "inc/tm4c123gh6pm.h"  // Board specific defines (for PF0)
 #include "buttons4.h"
+#include "eventQueue.h"
 
 
 // *******************************************************
@@ -31,7 +32,6 @@
 // *******************************************************
 static bool but_state[NUM_BUTS];	// Corresponds to the electrical state
 static uint8_t but_count[NUM_BUTS];
-static bool but_flag[NUM_BUTS];
 static bool but_normal[NUM_BUTS];   // Corresponds to the electrical state
 
 // *******************************************************
@@ -78,7 +78,6 @@ initButtons (void)
 	{
 		but_state[i] = but_normal[i];
 		but_count[i] = 0;
-		but_flag[i] = false;
 	}
 }
 
@@ -90,7 +89,7 @@ initButtons (void)
 // Debounce algorithm: A state machine is associated with each button.
 // A state change occurs only after NUM_BUT_POLLS consecutive polls have
 // read the pin in the opposite condition, before the state changes and
-// a flag is set.  Set NUM_BUT_POLLS according to the polling rate.
+// an EVENT_BUTTON is posted.  Set NUM_BUT_POLLS according to the polling rate.
 void
 updateButtons (void)
 {
@@ -111,7 +110,7 @@ updateButtons (void)
         	if (but_count[i] >= NUM_BUT_POLLS)
         	{
         		but_state[i] = but_value[i];
-        		but_flag[i] = true;	   // Reset by call to checkButton()
+        		postEvent(EVENT_BUTTON, i, but_state[i] == but_normal[i] ? RELEASED : PUSHED);
         		but_count[i] = 0;
         	}
         }
@@ -119,21 +118,3 @@ updateButtons (void)
         	but_count[i] = 0;
 	}
 }
-
-// *******************************************************
-// checkButton: Function returns the new button logical state if the button
-// logical state (PUSHED or RELEASED) has changed since the last call,
-// otherwise returns NO_CHANGE.
-uint8_t
-checkButton (uint8_t butName)
-{
-	if (but_flag[butName])
-	{
-		but_flag[butName] = false;
-		if (but_state[butName] == but_normal[butName])
-			return RELEASED;
-		else
-			return PUSHED;
-	}
-	return NO_CHANGE;
-}
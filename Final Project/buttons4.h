@@ -47,7 +47,7 @@ enum butStates {RELEASED = 0, PUSHED, NO_CHANGE};
 // Debounce algorithm: A state machine is associated with each button.
 // A state change occurs only after NUM_BUT_POLLS consecutive polls have
 // read the pin in the opposite condition, before the state changes and
-// a flag is set.  Set NUM_BUT_POLLS according to the polling rate.
+// an EVENT_BUTTON is posted.  Set NUM_BUT_POLLS according to the polling rate.
 
 // *******************************************************
 // initButtons: Initialise the variables associated with the set of buttons
@@ -63,12 +63,4 @@ initButtons (void);
 void
 updateButtons (void);
 
-// *******************************************************
-// checkButton: Function returns the new button state if the button state
-// (PUSHED or RELEASED) has changed since the last call, otherwise returns
-// NO_CHANGE.  The argument butName should be one of constants in the
-// enumeration butStates, excluding 'NUM_BUTS'. Safe under interrupt.
-uint8_t
-checkButton (uint8_t butName);
-
 #endif /*BUTTONS_H_*/
@@ -10,25 +10,34 @@
 // *******************************************************
 
 #include <stdint.h>
-#include "stdlib.h"
+#include <stddef.h>
 #include "circBufT.h"
 
 // *******************************************************
-// initCircBuf: Initialise the circBuf instance. Reset both indices to
-// the start of the buffer.  Dynamically allocate and clear the the 
-// memory and return a pointer for the data.  Return NULL if 
-// allocation fails.
+// initCircBuf: Initialise the circBuf instance over storage, which
+// the caller provides with room for size entries, usually a static
+// array so nothing is allocated at run time. Reset both indices to
+// the start of the buffer, clear the storage and return a pointer
+// for the data.  Return NULL if there is no storage or size is 0.
 uint32_t *
-initCircBuf (circBuf_t *buffer, uint32_t size)
+initCircBuf (circBuf_t *buffer, uint32_t *storage, uint32_t size)
 {
+	uint32_t i;
+
 	buffer->windex = 0;
 	buffer->rindex = 0;
+	if (storage == NULL || size == 0)
+	{
+		buffer->size = 0;
+		buffer->data = NULL;
+		return NULL;
+	}
 	buffer->size = size;
-	buffer->data = 
-        (uint32_t *) calloc (size, sizeof(uint32_t));
+	buffer->data = storage;
+	for (i = 0; i < size; i++)
+		buffer->data[i] = 0;
 	return buffer->data;
 }
-   // Note use of calloc() to clear contents.
 
 // *******************************************************
 // writeCircBuf: insert entry at the current windex location,
@@ -59,16 +68,15 @@ readCircBuf (circBuf_t *buffer)
 }
 
 // *******************************************************
-// freeCircBuf: Releases the memory allocated to the buffer data,
-// sets pointer to NULL and ohter fields to 0. The buffer can
-// re-initialised by another call to initCircBuf().
+// freeCircBuf: Releases the buffer from its storage, sets pointer
+// to NULL and other fields to 0. The buffer can be re-initialised
+// by another call to initCircBuf().
 void
 freeCircBuf (circBuf_t * buffer)
 {
 	buffer->windex = 0;
 	buffer->rindex = 0;
 	buffer->size = 0;
-	free (buffer->data);
 	buffer->data = NULL;
 }
 
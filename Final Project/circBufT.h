@@ -23,12 +23,13 @@ typedef struct {
 } circBuf_t;
 
 // *******************************************************
-// initCircBuf: Initialise the circBuf instance. Reset both indices to
-// the start of the buffer.  Dynamically allocate and clear the the 
-// memory and return a pointer for the data.  Return NULL if 
-// allocation fails.
+// initCircBuf: Initialise the circBuf instance over storage, which
+// the caller provides with room for size entries, usually a static
+// array so nothing is allocated at run time. Reset both indices to
+// the start of the buffer, clear the storage and return a pointer
+// for the data.  Return NULL if there is no storage or size is 0.
 uint32_t *
-initCircBuf (circBuf_t *buffer, uint32_t size);
+initCircBuf (circBuf_t *buffer, uint32_t *storage, uint32_t size);
 
 // *******************************************************
 // writeCircBuf: insert entry at the current windex location,
@@ -44,9 +45,9 @@ uint32_t
 readCircBuf (circBuf_t *buffer);
 
 // *******************************************************
-// freeCircBuf: Releases the memory allocated to the buffer data,
-// sets pointer to NULL and other fields to 0. The buffer can
-// re initialised by another call to initCircBuf().
+// freeCircBuf: Releases the buffer from its storage, sets pointer
+// to NULL and other fields to 0. The buffer can be re initialised
+// by another call to initCircBuf().
 void
 freeCircBuf (circBuf_t *buffer);
 
@@ -0,0 +1,323 @@
+/*
+ * commands.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Module runs the commands received on the UART. The receive interrupt
+ *      posts each character as an EVENT_UART_RX, so the line is built and the command run
+ *      in the main loop, where setTaskRate() may be called. A new rate is checked against
+ *      the task budgets before it is applied, and the reply is left for the UART task to
+ *      send with its next update rather than waiting on the transmit FIFO here.
+ */
+
+#include "commands.h"
+#include "scheduler.h"
+#include "schedulability.h"
+#include "altitude.h"
+#include "pwm.h"
+#include "display.h"
+#include "utils/ustdlib.h"
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+static char commandLine[COMMAND_LINE_LEN];  // Line being received
+static size_t commandLength;
+static bool commandTooLong;                 // Characters were lost from the line
+static char reply[COMMAND_REPLY_LEN];
+static bool replyWaiting;
+
+//*******************************************************************************************
+// @param text Text to skip spaces from
+//
+// @return const char* The first character that is not a space
+//*******************************************************************************************
+static const char *
+skipSpaces(const char *text)
+{
+    while (*text == ' ') {
+        text++;
+    }
+    return text;
+}
+
+//*******************************************************************************************
+// @param text Text the command starts at
+//
+// @param name Name of the command
+//
+// @param length Length of the name
+//
+// @return const char* The first argument, or NULL if the text is not the command
+//*******************************************************************************************
+static const char *
+matchCommand(const char *text, const char *name, size_t length)
+{
+    if (ustrncmp(text, name, length) != 0 || (text[length] != ' ' && text[length] != '\0')) {
+        return NULL;
+    }
+    return skipSpaces(text + length);
+}
+
+//*******************************************************************************************
+// @param next The factor, or nothing to give the current one
+//
+// Sets the hardware averaging of each altitude sample step
+//*******************************************************************************************
+static void
+runOversample(const char *next)
+{
+    const char *end;
+    uint32_t factor;
+
+    if (*next != '\0') {
+        factor = ustrtoul(next, &end, 10);
+        if (end == next || *skipSpaces(end) != '\0' || !setAdcOversample(factor)) {
+            usnprintf(reply, sizeof(reply), "Oversample must be 1 or a power of 2 to %d\r\n",
+                      ADC_MAX_OVERSAMPLE);
+            return;
+        }
+    }
+    usnprintf(reply, sizeof(reply), "Oversample %d, %d steps per sample\r\n",
+              getAdcOversample(), ADC_BURST_STEPS);
+}
+
+//*******************************************************************************************
+// @param next The filter and its coefficients, or nothing to give the current one
+//
+// Selects the altitude filter. Coefficients not given keep the filter's preset values.
+//*******************************************************************************************
+static void
+runFilterCommand(const char *next)
+{
+    filterConfig_t config;
+    filterType_t type;
+    const char *end;
+    size_t length;
+    size_t used;
+    uint32_t index;
+    int32_t sign;
+
+    if (*next != '\0') {
+        length = filterFromName(next, &type);
+        if (length == 0) {
+            usnprintf(reply, sizeof(reply), "Filters are boxcar, iir1, iir2, cic, median\r\n");
+            return;
+        }
+        getAltitudeFilterPreset(type, &config);
+        next = skipSpaces(next + length);
+        for (index = 0; index < filterCoefficientCount(type) && *next != '\0'; index++) {
+            sign = *next == '-' ? -1 : 1;
+            if (sign < 0) {
+                next++;
+            }
+            config.coefficients[index] = sign * (int32_t)ustrtoul(next, &end, 10);
+            if (end == next) {
+                break;
+            }
+            next = skipSpaces(end);
+        }
+        if (*next != '\0' || !setAltitudeFilter(&config)) {
+            usnprintf(reply, sizeof(reply), "Filter %s coefficients not valid, unchanged\r\n",
+                      filterName(type));
+            return;
+        }
+    }
+    getAltitudeFilter(&config);
+    used = usnprintf(reply, sizeof(reply), "Filter %s", filterName(config.type));
+    for (index = 0; index < filterCoefficientCount(config.type) && used < sizeof(reply);
+            index++) {
+        used += usnprintf(reply + used, sizeof(reply) - used, " %d", config.coefficients[index]);
+    }
+    if (used < sizeof(reply)) {
+        usnprintf(reply + used, sizeof(reply) - used, ", lag %d ms\r\n",
+                  getAltitudeFilterDelayUs() / TIME_US_PER_MS);
+    }
+}
+
+//*******************************************************************************************
+// @param next The page, or nothing to give the current one
+//
+// Selects the page the OLED shows
+//*******************************************************************************************
+static void
+runDisplayCommand(const char *next)
+{
+    const char *flight = matchCommand(next, "flight", 6);
+    const char *load = matchCommand(next, "load", 4);
+
+    if (flight != NULL && *flight == '\0') {
+        setDisplayPage(DISPLAY_FLIGHT_PAGE);
+    } else if (load != NULL && *load == '\0') {
+        setDisplayPage(DISPLAY_LOAD_PAGE);
+    } else if (*next != '\0') {
+        usnprintf(reply, sizeof(reply), "Display pages are flight, load\r\n");
+        return;
+    }
+    usnprintf(reply, sizeof(reply), "Display %s\r\n",
+              getDisplayPage() == DISPLAY_LOAD_PAGE ? "load" : "flight");
+}
+
+//*******************************************************************************************
+// Replies with the rate and phase of every task
+//*******************************************************************************************
+static void
+listRates(void)
+{
+    size_t used = usnprintf(reply, sizeof(reply), "Rates");
+    size_t index;
+    for (index = 0; index < NUMTASKS && used < sizeof(reply); index++) {
+        used += usnprintf(reply + used, sizeof(reply) - used, " T%d %dHz p%d",
+                          (uint32_t)index, SYSTICK_RATE_HZ / getTask(index)->numTicksCycle,
+                          getTask(index)->phase);
+    }
+    if (used < sizeof(reply)) {
+        usnprintf(reply + used, sizeof(reply) - used, "\r\n");
+    }
+}
+
+//*******************************************************************************************
+// @param index Index of the task
+//
+// @param rateHz New release rate
+//
+// @param phase Tick within the new cycle to release on, or AUTO_PHASE
+//
+// Applies the rate if it divides the tick and the budgets stay schedulable. A task
+// triggered by the ADC is released by its events, so the samples between events change
+// with it and the tick only takes over if they stop.
+//*******************************************************************************************
+static void
+changeRate(size_t index, uint32_t rateHz, uint16_t phase)
+{
+    bool adcTriggered = taskTable[index].trigger == EVENT_ADC_SAMPLES;
+
+    if (rateHz == 0 || SYSTICK_RATE_HZ % rateHz != 0
+            || (adcTriggered && SAMPLE_RATE_HZ % rateHz != 0)) {
+        usnprintf(reply, sizeof(reply), "T%d rate must divide %d Hz\r\n",
+                  (uint32_t)index, SYSTICK_RATE_HZ);
+    } else if (!checkTaskRate(index, rateHz)) {
+        usnprintf(reply, sizeof(reply), "T%d at %d Hz may miss deadlines, unchanged\r\n",
+                  (uint32_t)index, rateHz);
+    } else if (!setTaskRate(index, rateHz, phase)) {
+        usnprintf(reply, sizeof(reply), "T%d phase must be below %d\r\n",
+                  (uint32_t)index, SYSTICK_RATE_HZ / rateHz);
+    } else {
+        if (adcTriggered) {
+            setAdcEventSamples(SAMPLE_RATE_HZ / rateHz);
+        }
+        usnprintf(reply, sizeof(reply), "T%d now %d Hz phase %d, worst tick %d tasks\r\n",
+                  (uint32_t)index, rateHz, getTask(index)->phase, getWorstTickLoad());
+    }
+}
+
+//*******************************************************************************************
+// Runs the command in commandLine and leaves its reply
+//*******************************************************************************************
+static void
+runCommand(void)
+{
+    const char *next = skipSpaces(commandLine);
+    const char *end;
+    uint32_t index;
+    uint32_t rateHz;
+    uint32_t phase = AUTO_PHASE;
+
+    const char *arguments = matchCommand(next, "oversample", 10);
+
+    if (arguments != NULL) {
+        runOversample(arguments);
+        return;
+    }
+    arguments = matchCommand(next, "filter", 6);
+    if (arguments != NULL) {
+        runFilterCommand(arguments);
+        return;
+    }
+    arguments = matchCommand(next, "display", 7);
+    if (arguments != NULL) {
+        runDisplayCommand(arguments);
+        return;
+    }
+    next = matchCommand(next, "rate", 4);
+    if (next == NULL) {
+        usnprintf(reply, sizeof(reply), "Unknown command, try rate, oversample, filter or display\r\n");
+        return;
+    }
+    if (*next == '\0') {
+        listRates();
+        return;
+    }
+
+    // The task by index, with or without the T the reports use
+    if (*next == 'T' || *next == 't') {
+        next++;
+    }
+    index = ustrtoul(next, &end, 10);
+    if (end == next || index >= NUMTASKS) {
+        usnprintf(reply, sizeof(reply), "No task %s\r\n", next);
+        return;
+    }
+    next = skipSpaces(end);
+    rateHz = ustrtoul(next, &end, 10);
+    if (end == next) {
+        usnprintf(reply, sizeof(reply), "T%d needs a rate in Hz\r\n", index);
+        return;
+    }
+    next = skipSpaces(end);
+    if (*next != '\0') {
+        phase = ustrtoul(next, &end, 10);
+        if (end == next || phase >= AUTO_PHASE) {
+            usnprintf(reply, sizeof(reply), "T%d phase %s not understood\r\n", index, next);
+            return;
+        }
+    }
+    changeRate(index, rateHz, phase);
+}
+
+//*******************************************************************************************
+// @param event An EVENT_UART_RX event carrying the next character received
+//
+// Collects characters into a line and runs the command once the line ends. Register
+// for EVENT_UART_RX with setEventHandler().
+//*******************************************************************************************
+void
+commandEventHandler(const event_t *event)
+{
+    char character = (char)event->value;
+
+    if (character == '\r' || character == '\n') {
+        if (commandTooLong) {
+            usnprintf(reply, sizeof(reply), "Command over %d characters\r\n",
+                      COMMAND_LINE_LEN - 1);
+            replyWaiting = true;
+        } else if (commandLength > 0) {
+            commandLine[commandLength] = '\0';
+            runCommand();
+            replyWaiting = true;
+        }
+        commandLength = 0;
+        commandTooLong = false;
+    } else if (commandLength < COMMAND_LINE_LEN - 1) {
+        commandLine[commandLength++] = character;
+    } else {
+        commandTooLong = true;
+    }
+}
+
+//*******************************************************************************************
+// @param buffer Filled with the reply to the last command, ended by "\r\n"
+//
+// @param length Size of buffer
+//
+// @return bool False if no reply is waiting. A reply is only returned once.
+//*******************************************************************************************
+bool
+takeCommandReply(char *buffer, size_t length)
+{
+    if (!replyWaiting) {
+        return false;
+    }
+    usnprintf(buffer, length, "%s", reply);
+    replyWaiting = false;
+    return true;
+}
@@ -0,0 +1,59 @@
+/*
+ * commands.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the command channel. Lines typed on the UART change
+ *      the task rates while the helicopter runs, so display and telemetry rates can be
+ *      traded against the control rate on the rig without reflashing. Commands, ended by
+ *      a carriage return or new line:
+ *          rate                        lists every task's rate and phase
+ *          rate <task> <Hz> [phase]    releases task T<task> at Hz, on phase if given
+ *          oversample [factor]         gives or sets the ADC conversions per step
+ *          filter [type [coefficients]]
+ *                                      gives or sets the altitude filter: boxcar, iir1,
+ *                                      iir2, cic or median, then its integer coefficients
+ *                                      in the order filters.h lists them, any left out
+ *                                      taking the preset in altitude.h. Replies with the
+ *                                      filter running and its lag, e.g.
+ *                                      "Filter iir1 2048, lag 46 ms"
+ *          display [flight|load]       gives or sets the page the OLED shows, the flight
+ *                                      parameters or the CPU and task load
+ */
+
+#ifndef COMMANDS_H_
+#define COMMANDS_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "eventQueue.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+#define COMMAND_LINE_LEN 48         // Longest command, longer lines are discarded
+#define COMMAND_REPLY_LEN 64
+
+//*******************************************************************************************
+// @param event An EVENT_UART_RX event carrying the next character received
+//
+// Collects characters into a line and runs the command once the line ends. Register
+// for EVENT_UART_RX with setEventHandler().
+//*******************************************************************************************
+void
+commandEventHandler(const event_t *event);
+
+//*******************************************************************************************
+// @param buffer Filled with the reply to the last command, ended by "\r\n"
+//
+// @param length Size of buffer
+//
+// @return bool False if no reply is waiting. A reply is only returned once.
+//*******************************************************************************************
+bool
+takeCommandReply(char *buffer, size_t length);
+
+#endif /* COMMANDS_H_ */
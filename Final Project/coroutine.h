@@ -0,0 +1,75 @@
+/*
+ * coroutine.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Stackless coroutines for scheduler tasks, in the style of protothreads.
+ *      A long task can yield part way through and carry on from the same point the next
+ *      time the scheduler runs it, so higher priority tasks get in between its slices.
+ *
+ *      The resume point is a line number kept in a static coroutine_t, and the macros
+ *      expand to a switch on it, so:
+ *          - local variables are lost at a yield, keep anything needed after one static
+ *          - the task body must not use a switch statement of its own around a yield
+ *
+ *      void
+ *      longTask(void)
+ *      {
+ *          static coroutine_t co;
+ *          static int i;
+ *          COROUTINE_BEGIN(co);
+ *          for (i = 0; i < 4; i++) {
+ *              doPart(i);
+ *              COROUTINE_YIELD(co);
+ *          }
+ *          COROUTINE_END(co);
+ *      }
+ */
+
+#ifndef COROUTINE_H_
+#define COROUTINE_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include "scheduler.h"
+
+//*******************************************************************************************
+// Resume point of a coroutine, 0 to start from the top
+//*******************************************************************************************
+typedef uint16_t coroutine_t;
+
+//*******************************************************************************************
+// Starts the coroutine body, resuming where it last yielded
+//*******************************************************************************************
+#define COROUTINE_BEGIN(co) switch (co) { case 0:
+
+//*******************************************************************************************
+// Returns to the scheduler through yield(), carrying on after this point on the next run
+//*******************************************************************************************
+#define COROUTINE_SUSPEND(co, yield) \
+    do { \
+        (co) = __LINE__; \
+        yield(); \
+        return; \
+        case __LINE__:; \
+    } while (0)
+
+//*******************************************************************************************
+// Returns to the scheduler, which runs the task again as soon as no higher priority task
+// is ready. The next run carries on after the yield.
+//*******************************************************************************************
+#define COROUTINE_YIELD(co) COROUTINE_SUSPEND(co, yieldTask)
+
+//*******************************************************************************************
+// As COROUTINE_YIELD(), but the task is not run again before the next tick. For waiting on
+// hardware, such as a full transmit FIFO, without keeping the processor awake.
+//*******************************************************************************************
+#define COROUTINE_WAIT_TICK(co) COROUTINE_SUSPEND(co, yieldTaskUntilTick)
+
+//*******************************************************************************************
+// Ends the coroutine body, so the next release starts from the top
+//*******************************************************************************************
+#define COROUTINE_END(co) } (co) = 0
+
+#endif /* COROUTINE_H_ */
@@ -0,0 +1,140 @@
+/*
+ * cpuLoad.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Module accounts for where the processor's time goes. The scheduler
+ *      adds the time it sleeps in WFI and the time each task runs to the current slot,
+ *      and a slot is closed into a ring of the last LOAD_SLOTS seconds once a second of
+ *      the cycle counter has passed. Everything runs in the main loop, so no interrupt
+ *      can interleave with an update. A hard tier task's time is counted once, as its
+ *      own, and left out of any background task it preempted. Time spent in the other
+ *      interrupt handlers is counted in the task they preempted, and the rest of the
+ *      time neither idle nor in a task went on the scheduler itself.
+ */
+
+#include "cpuLoad.h"
+#include "profiler.h"
+
+//*******************************************************************************************
+// Structs
+//*******************************************************************************************
+typedef struct {
+    uint32_t lengthCycles;          // Cycle counter time the slot covers
+    uint32_t idleCycles;
+    uint32_t taskCycles[NUMTASKS];
+} loadSlot_t;
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+static loadSlot_t current;                  // Slot being filled
+static uint32_t currentStart;               // Cycle counter at the start of the current slot
+static uint32_t slotCycles;                 // Cycles in a second
+static loadSlot_t slots[LOAD_SLOTS];        // Closed slots, the newest at newestSlot
+static size_t newestSlot;
+static size_t slotsClosed;                  // Closed slots holding data, up to LOAD_SLOTS
+
+//*******************************************************************************************
+// Clears the load slots. Call after initProfiler(), as the times come from its cycle
+// counter.
+//*******************************************************************************************
+void
+initCpuLoad(void)
+{
+    current = (loadSlot_t){0};
+    slotsClosed = 0;
+    newestSlot = LOAD_SLOTS - 1;
+    slotCycles = SysCtlClockGet();
+    currentStart = profileStart();
+}
+
+//*******************************************************************************************
+// Closes the current slot once a second has passed
+//*******************************************************************************************
+void
+updateCpuLoad(void)
+{
+    uint32_t now = profileStart();
+    if (now - currentStart < slotCycles) {
+        return;
+    }
+    current.lengthCycles = now - currentStart;
+    newestSlot = (newestSlot + 1) % LOAD_SLOTS;
+    slots[newestSlot] = current;
+    if (slotsClosed < LOAD_SLOTS) {
+        slotsClosed++;
+    }
+    current = (loadSlot_t){0};
+    currentStart = now;
+}
+
+//*******************************************************************************************
+// @param cycles Time the processor spent asleep waiting for an interrupt
+//*******************************************************************************************
+void
+addIdleCycles(uint32_t cycles)
+{
+    current.idleCycles += cycles;
+}
+
+//*******************************************************************************************
+// @param index Scheduler index of the task
+//
+// @param cycles Time the task just ran for, less any hard tier task time within it
+//*******************************************************************************************
+void
+addTaskCycles(size_t index, uint32_t cycles)
+{
+    current.taskCycles[index] += cycles;
+}
+
+//*******************************************************************************************
+// @param window Window to add up
+//
+// @param index Task to add up, or NUMTASKS for the idle time
+//
+// @return uint32_t The time in parts per thousand of the window, 0 if no slot is closed
+//*******************************************************************************************
+static uint32_t
+windowShare(loadWindow_t window, size_t index)
+{
+    size_t count = window == LOAD_1S ? 1 : LOAD_SLOTS;
+    uint64_t length = 0;
+    uint64_t cycles = 0;
+    size_t slot = newestSlot;
+
+    if (count > slotsClosed) {
+        count = slotsClosed;
+    }
+    while (count > 0) {
+        length += slots[slot].lengthCycles;
+        cycles += index < NUMTASKS ? slots[slot].taskCycles[index] : slots[slot].idleCycles;
+        slot = (slot + LOAD_SLOTS - 1) % LOAD_SLOTS;
+        count--;
+    }
+    return length > 0 ? (uint32_t)(cycles * LOAD_PER_MILLE / length) : 0;
+}
+
+//*******************************************************************************************
+// @param window Window to report
+//
+// @return uint32_t Time the processor was not idle, in parts per thousand
+//*******************************************************************************************
+uint32_t
+getCpuLoad(loadWindow_t window)
+{
+    return slotsClosed > 0 ? LOAD_PER_MILLE - windowShare(window, NUMTASKS) : 0;
+}
+
+//*******************************************************************************************
+// @param index Scheduler index of the task
+//
+// @param window Window to report
+//
+// @return uint32_t Time the task ran, in parts per thousand
+//*******************************************************************************************
+uint32_t
+getTaskLoad(size_t index, loadWindow_t window)
+{
+    return windowShare(window, index);
+}
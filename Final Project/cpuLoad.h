@@ -0,0 +1,84 @@
+/*
+ * cpuLoad.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the CPU load accounting. Idle time is measured while
+ *      the scheduler sleeps and each task's time as it runs, in one second slots, so the
+ *      load over the last second and the last ten seconds shows how much headroom the
+ *      system clock leaves.
+ */
+
+#ifndef CPULOAD_H_
+#define CPULOAD_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "driverlib/sysctl.h"
+#include "tasks.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+#define LOAD_SLOTS 10               // One second slots kept, the longest window
+#define LOAD_PER_MILLE 1000
+
+//*******************************************************************************************
+// Load windows, each ending at the last full second
+//*******************************************************************************************
+typedef enum {
+    LOAD_1S = 0,
+    LOAD_10S,
+    NUM_LOAD_WINDOWS
+} loadWindow_t;
+
+//*******************************************************************************************
+// Clears the load slots. Call after initProfiler(), as the times come from its cycle
+// counter.
+//*******************************************************************************************
+void
+initCpuLoad(void);
+
+//*******************************************************************************************
+// Closes the current slot once a second has passed. Called by the scheduler every pass.
+//*******************************************************************************************
+void
+updateCpuLoad(void);
+
+//*******************************************************************************************
+// @param cycles Time the processor spent asleep waiting for an interrupt
+//*******************************************************************************************
+void
+addIdleCycles(uint32_t cycles);
+
+//*******************************************************************************************
+// @param index Scheduler index of the task
+//
+// @param cycles Time the task just ran for, less any hard tier task time within it
+//*******************************************************************************************
+void
+addTaskCycles(size_t index, uint32_t cycles);
+
+//*******************************************************************************************
+// @param window Window to report
+//
+// @return uint32_t Time the processor was not idle, tasks, interrupts and the scheduler
+// together, in parts per thousand. 0 until the first second has passed.
+//*******************************************************************************************
+uint32_t
+getCpuLoad(loadWindow_t window);
+
+//*******************************************************************************************
+// @param index Scheduler index of the task
+//
+// @param window Window to report
+//
+// @return uint32_t Time the task ran, in parts per thousand
+//*******************************************************************************************
+uint32_t
+getTaskLoad(size_t index, loadWindow_t window);
+
+#endif /* CPULOAD_H_ */
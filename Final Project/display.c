@@ -9,6 +9,12 @@
  */
 
 #include "display.h"
+#include "sensors.h"
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+static volatile displayPage_t displayPage = DISPLAY_BOOT_PAGE;
 
 // *******************************************************
 // Initialises the oled display on Tiva Board
@@ -20,6 +26,62 @@ initDisplay (void)
     OLEDInitialise ();
 }
 
+// ***************************************************************************
+// @param row Display row to draw, 0 to DISPLAY_ROWS - 1
+//
+// Other parameters as displayParameters()
+// ***************************************************************************
+static void
+drawParameterRow(uint8_t row, int32_t altitude, int32_t yawVal, int32_t yawDecimal, int32_t altitudePwm, int32_t yawPwm)
+{
+    char string[17];
+    switch (row) {
+    case 0:
+        usnprintf(string, sizeof(string), "Altitude = %3d%%" , altitude);
+        break;
+    case 1:
+        usnprintf (string, sizeof(string), "Yaw = %3d.%1d  ", yawVal, yawDecimal );
+        break;
+    case 2:
+        usnprintf (string, sizeof(string), "Main Pwm = %4d%%  ", altitudePwm);
+        break;
+    default:
+        usnprintf (string, sizeof(string), "Tail Pwm = %4d%%", yawPwm);
+        break;
+    }
+    OLEDStringDraw (string, 0, row);
+}
+
+// ***************************************************************************
+// @param row Display row to draw, 0 to DISPLAY_ROWS - 1
+//
+// Draws a row of the load page: the CPU load over each window, then the
+// load of the first four tasks over the last second
+// ***************************************************************************
+static void
+drawLoadRow(uint8_t row)
+{
+    char string[17];
+    size_t first = (row - 2) * 2;
+    uint32_t load;
+
+    if (row < NUM_LOAD_WINDOWS) {
+        load = getCpuLoad((loadWindow_t)row);
+        usnprintf(string, sizeof(string), "CPU %s %3d.%1d%%     ", row == LOAD_1S ? "1s " : "10s",
+                  load / 10, load % 10);
+    } else if (first + 1 < NUMTASKS) {
+        usnprintf(string, sizeof(string), "T%d %d.%1d%% T%d %d.%1d%%   ",
+                  (uint32_t)first, getTaskLoad(first, LOAD_1S) / 10, getTaskLoad(first, LOAD_1S) % 10,
+                  (uint32_t)first + 1, getTaskLoad(first + 1, LOAD_1S) / 10, getTaskLoad(first + 1, LOAD_1S) % 10);
+    } else if (first < NUMTASKS) {
+        usnprintf(string, sizeof(string), "T%d %d.%1d%%         ",
+                  (uint32_t)first, getTaskLoad(first, LOAD_1S) / 10, getTaskLoad(first, LOAD_1S) % 10);
+    } else {
+        usnprintf(string, sizeof(string), "                ");
+    }
+    OLEDStringDraw (string, 0, row);
+}
+
 // ***************************************************************************
 // @param altitude Inputs the current altitude from the adc and processed altitude
 //
@@ -36,21 +98,53 @@ initDisplay (void)
 void
 displayParameters(int32_t altitude, int32_t yawVal, int32_t yawDecimal, int32_t altitudePwm, int32_t yawPwm)
 {
-    char string[17];
-    usnprintf(string, sizeof(string), "Altitude = %3d%%" , altitude);
-    OLEDStringDraw (string, 0, 0);
-    usnprintf (string, sizeof(string), "Yaw = %3d.%1d  ", yawVal, yawDecimal );
-    OLEDStringDraw (string, 0, 1);
-    usnprintf (string, sizeof(string), "Main Pwm = %4d%%  ", altitudePwm);
-    OLEDStringDraw (string, 0, 2);
-    usnprintf (string, sizeof(string), "Tail Pwm = %4d%%", yawPwm);
-    OLEDStringDraw (string, 0, 3);
+    uint8_t row;
+    for (row = 0; row < DISPLAY_ROWS; row++) {
+        drawParameterRow(row, altitude, yawVal, yawDecimal, altitudePwm, yawPwm);
+    }
+}
+
+// ***************************************************************************
+// @param page Page to show from the next update
+// ***************************************************************************
+void
+setDisplayPage(displayPage_t page)
+{
+    displayPage = page;
 }
 
 // ***************************************************************************
-// The function that is attached to the scheduler
+// @return displayPage_t The page being shown
+// ***************************************************************************
+displayPage_t
+getDisplayPage(void)
+{
+    return displayPage;
+}
+
+// ***************************************************************************
+// The function that is attached to the scheduler. Draws a row at a time and
+// yields between them, as each row is a slow transfer to the display. The
+// page is only read at the start of an update, so every row of an update is
+// drawn from the one page and the one sensor snapshot.
 // ***************************************************************************
 void
 displaySchedulerFunc(void) {
-    displayParameters(processAltitude(), getYawOutput(), getYawDecimal(), getAltitudePwm(), getYawPwm());
+    static coroutine_t displayCoroutine;
+    static uint8_t row;
+    static displayPage_t page;
+    static sensorSnapshot_t sensors;
+
+    COROUTINE_BEGIN(displayCoroutine);
+    getSensorSnapshot(&sensors);
+    page = displayPage;
+    for (row = 0; row < DISPLAY_ROWS; row++) {
+        if (page == DISPLAY_LOAD_PAGE) {
+            drawLoadRow(row);
+        } else {
+            drawParameterRow(row, sensors.altitude, sensors.yawAngle, sensors.yawDecimal, sensors.altitudePwm, sensors.yawPwm);
+        }
+        COROUTINE_YIELD(displayCoroutine);
+    }
+    COROUTINE_END(displayCoroutine);
 }
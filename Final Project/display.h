@@ -25,6 +25,22 @@
 #include "yaw.h"
 #include "altitude.h"
 #include "pwm.h"
+#include "coroutine.h"
+#include "cpuLoad.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+#define DISPLAY_ROWS 4
+#define DISPLAY_BOOT_PAGE DISPLAY_FLIGHT_PAGE   // Page shown until the display command
+
+//*******************************************************************************************
+// Pages the display can show
+//*******************************************************************************************
+typedef enum {
+    DISPLAY_FLIGHT_PAGE = 0,    // Altitude, yaw and the rotor PWMs
+    DISPLAY_LOAD_PAGE           // CPU load and the load of the first tasks
+} displayPage_t;
 
 // ***************************************************************************
 // Initialises the oled display on Tiva Board
@@ -49,7 +65,20 @@ void
 displayParameters(int32_t altitude, int32_t yawVal, int32_t yawDecimal, int32_t altitudePwm, int32_t yawPwm);
 
 // ***************************************************************************
-// The function that is attached to the scheduler
+// @param page Page to show from the next update
+// ***************************************************************************
+void
+setDisplayPage(displayPage_t page);
+
+// ***************************************************************************
+// @return displayPage_t The page being shown
+// ***************************************************************************
+displayPage_t
+getDisplayPage(void);
+
+// ***************************************************************************
+// The function that is attached to the scheduler, drawing a row per run of
+// the page selected with setDisplayPage()
 // ***************************************************************************
 void
 displaySchedulerFunc(void);
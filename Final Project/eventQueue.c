@@ -0,0 +1,147 @@
+/*
+ * eventQueue.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Module for a wait-free single producer, single consumer event queue.
+ *      The interrupt handlers only ever move the head and the main loop only ever moves
+ *      the tail, each after its own access to the slot, so neither side needs to mask
+ *      interrupts. The indices run freely and are masked into the buffer, so a full queue
+ *      is told apart from an empty one without wasting a slot.
+ */
+
+#include "eventQueue.h"
+#include "scheduler.h"
+#include "timeBase.h"
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+static volatile event_t queue[EVENT_QUEUE_SIZE];
+static volatile uint32_t head;      // Next slot to post to, moved by the producer
+static volatile uint32_t tail;      // Next slot to handle, moved by the consumer
+static uint32_t counts[NUM_EVENT_TYPES];
+static uint32_t overflows;
+static uint32_t highWater;
+static void (*handlers[NUM_EVENT_TYPES])(const event_t *event);
+
+//*******************************************************************************************
+// Empties the queue and clears its counts
+//*******************************************************************************************
+void
+initEventQueue(void)
+{
+    size_t type;
+    head = 0;
+    tail = 0;
+    overflows = 0;
+    highWater = 0;
+    for (type = 0; type < NUM_EVENT_TYPES; type++) {
+        counts[type] = 0;
+    }
+}
+
+//*******************************************************************************************
+// @param type Type of the event
+//
+// @param source What raised it, such as the button or switch
+//
+// @param value Value of the event
+//
+// @return bool False if the queue was full and the event was lost
+//*******************************************************************************************
+bool
+postEvent(eventType_t type, uint8_t source, uint16_t value)
+{
+    uint32_t depth = head - tail;
+    volatile event_t *slot;
+
+    // Tasks triggered by the event run as soon as possible, even if it is lost
+    releaseTriggered(type);
+    if (depth >= EVENT_QUEUE_SIZE) {
+        overflows++;
+        return false;
+    }
+    slot = &queue[head & (EVENT_QUEUE_SIZE - 1)];
+    slot->timeUs = getTimeUs();
+    slot->value = value;
+    slot->type = type;
+    slot->source = source;
+    // Publish only once the slot is written
+    head++;
+
+    counts[type]++;
+    if (depth + 1 > highWater) {
+        highWater = depth + 1;
+    }
+    return true;
+}
+
+//*******************************************************************************************
+// @return bool True if events are waiting to be handled
+//*******************************************************************************************
+bool
+eventsPending(void)
+{
+    return head != tail;
+}
+
+//*******************************************************************************************
+// @param type Type of event
+//
+// @param handler Called from the main loop with each event of the type
+//*******************************************************************************************
+void
+setEventHandler(eventType_t type, void (*handler)(const event_t *event))
+{
+    handlers[type] = handler;
+}
+
+//*******************************************************************************************
+// Hands every waiting event to its handler, oldest first
+//*******************************************************************************************
+void
+handleEvents(void)
+{
+    while (tail != head) {
+        volatile event_t *slot = &queue[tail & (EVENT_QUEUE_SIZE - 1)];
+        event_t event;
+        event.timeUs = slot->timeUs;
+        event.value = slot->value;
+        event.type = slot->type;
+        event.source = slot->source;
+        // Free the slot only once it is copied
+        tail++;
+        if (event.type < NUM_EVENT_TYPES && handlers[event.type] != NULL) {
+            handlers[event.type](&event);
+        }
+    }
+}
+
+//*******************************************************************************************
+// @param type Type of event
+//
+// @return uint32_t Events of the type posted since initEventQueue()
+//*******************************************************************************************
+uint32_t
+getEventCount(eventType_t type)
+{
+    return counts[type];
+}
+
+//*******************************************************************************************
+// @return uint32_t Events lost to a full queue
+//*******************************************************************************************
+uint32_t
+getEventOverflows(void)
+{
+    return overflows;
+}
+
+//*******************************************************************************************
+// @return uint32_t Most events ever waiting at once
+//*******************************************************************************************
+uint32_t
+getEventHighWater(void)
+{
+    return highWater;
+}
@@ -0,0 +1,112 @@
+/*
+ * eventQueue.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the event queue. Interrupt handlers post timestamped
+ *      events that the scheduler hands to their handlers in order, between tasks.
+ */
+
+#ifndef EVENTQUEUE_H_
+#define EVENTQUEUE_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+// Must be a power of two, and hold every event posted while the longest task runs
+#define EVENT_QUEUE_SIZE 64
+
+//*******************************************************************************************
+// Event types
+//*******************************************************************************************
+typedef enum {
+    EVENT_BUTTON = 0,       // Button changed, source is the button, value PUSHED or RELEASED
+    EVENT_SWITCH,           // Takeoff switch changed, source RIGHT_SWITCH, value SWITCH_UP or SWITCH_DOWN
+    EVENT_REFERENCE,        // Yaw reference found and the yaw zeroed
+    EVENT_ADC_BLOCK,        // A full buffer of new altitude samples, value is the last sample
+    EVENT_ADC_SAMPLES,      // ADC_EVENT_SAMPLES new altitude samples, value is the last sample
+    EVENT_UART_RX,          // Character received on the UART, value is the character
+    NUM_EVENT_TYPES
+} eventType_t;
+
+//*******************************************************************************************
+// Structs
+//*******************************************************************************************
+typedef struct {
+    uint64_t timeUs;        // getTimeUs() when the event was posted
+    uint16_t value;
+    uint8_t type;
+    uint8_t source;
+} event_t;
+
+//*******************************************************************************************
+// Empties the queue and clears its counts
+//*******************************************************************************************
+void
+initEventQueue(void);
+
+//*******************************************************************************************
+// @param type Type of the event
+//
+// @param source What raised it, such as the button or switch
+//
+// @param value Value of the event
+//
+// @return bool False if the queue was full and the event was lost
+//
+// Called from interrupt handlers. Every handler that posts must share one interrupt
+// priority, so no two ever post at once and together they are the single producer.
+// Tasks with the event as their trigger are released straight away.
+//*******************************************************************************************
+bool
+postEvent(eventType_t type, uint8_t source, uint16_t value);
+
+//*******************************************************************************************
+// @return bool True if events are waiting to be handled
+//*******************************************************************************************
+bool
+eventsPending(void);
+
+//*******************************************************************************************
+// @param type Type of event
+//
+// @param handler Called from the main loop with each event of the type. Events without
+// a handler are counted and discarded.
+//*******************************************************************************************
+void
+setEventHandler(eventType_t type, void (*handler)(const event_t *event));
+
+//*******************************************************************************************
+// Hands every waiting event to its handler, oldest first. Only the scheduler calls this,
+// so it is the single consumer.
+//*******************************************************************************************
+void
+handleEvents(void);
+
+//*******************************************************************************************
+// @param type Type of event
+//
+// @return uint32_t Events of the type posted since initEventQueue()
+//*******************************************************************************************
+uint32_t
+getEventCount(eventType_t type);
+
+//*******************************************************************************************
+// @return uint32_t Events lost to a full queue
+//*******************************************************************************************
+uint32_t
+getEventOverflows(void);
+
+//*******************************************************************************************
+// @return uint32_t Most events ever waiting at once
+//*******************************************************************************************
+uint32_t
+getEventHighWater(void);
+
+#endif /* EVENTQUEUE_H_ */
@@ -0,0 +1,308 @@
+/*
+ * filters.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Module runs the filters of the digital filter library. Every filter
+ *      works in integer arithmetic: the boxcar keeps a running sum, the IIR filters keep
+ *      their outputs in Q FILTER_Q_BITS with 64 bit products and shifts rather than
+ *      divides, the CIC filter only adds and subtracts until its single divide per output
+ *      and the median sorts a handful of samples. A sample costs the same every time,
+ *      whatever the signal.
+ */
+
+#include "filters.h"
+#include "utils/ustdlib.h"
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+static const char *const filterNames[NUM_FILTER_TYPES] = {
+    "boxcar", "iir1", "iir2", "cic", "median"
+};
+static const uint8_t coefficientCounts[NUM_FILTER_TYPES] = { 1, 1, 5, 2, 1 };
+
+//*******************************************************************************************
+// @param config A FILTER_CIC config, already checked
+//
+// @return uint32_t The gain of its integrators and combs, decimation to the power order
+//*******************************************************************************************
+static uint32_t
+cicGain(const filterConfig_t *config)
+{
+    uint32_t gain = 1;
+    int32_t stage;
+
+    for (stage = 0; stage < config->coefficients[1]; stage++) {
+        gain *= config->coefficients[0];
+    }
+    return gain;
+}
+
+//*******************************************************************************************
+// @param config The filter and its coefficients
+//
+// @return bool False if the coefficients are out of the ranges filterType_t gives
+//*******************************************************************************************
+bool
+checkFilterConfig(const filterConfig_t *config)
+{
+    const int32_t *c = config->coefficients;
+
+    switch (config->type) {
+    case FILTER_BOXCAR:
+        return c[0] >= 1 && c[0] <= FILTER_MAX_TAPS;
+    case FILTER_IIR1:
+        return c[0] >= 1 && c[0] <= FILTER_ONE;
+    case FILTER_IIR2:
+        // Unity gain at DC, and both poles inside the unit circle
+        return c[0] + c[1] + c[2] == FILTER_ONE + c[3] + c[4]
+               && c[4] > -FILTER_ONE && c[4] < FILTER_ONE
+               && abs(c[3]) < FILTER_ONE + c[4];
+    case FILTER_CIC:
+        return c[0] >= 1 && c[0] <= FILTER_MAX_DECIMATION
+               && c[1] >= 1 && c[1] <= FILTER_MAX_CIC_ORDER;
+    case FILTER_MEDIAN:
+        return c[0] >= 1 && c[0] <= FILTER_MAX_MEDIAN && (c[0] & 1) != 0;
+    default:
+        return false;
+    }
+}
+
+//*******************************************************************************************
+// @param filter Filter to set up
+//
+// @param config The filter and its coefficients
+//
+// @param initial Output to start from, as if every sample so far had been this
+//
+// @return bool False if the coefficients are not valid, leaving the filter unusable
+//
+// Allocates nothing, so a filter can be set up again in place at any time.
+//*******************************************************************************************
+bool
+initFilter(filter_t *filter, const filterConfig_t *config, int32_t initial)
+{
+    uint32_t index;
+
+    if (!checkFilterConfig(config)) {
+        return false;
+    }
+    *filter = (filter_t){ .config = *config, .output = initial };
+    switch (config->type) {
+    case FILTER_BOXCAR:
+    case FILTER_MEDIAN:
+        initCircBuf(&filter->history, filter->historyData, config->coefficients[0]);
+        for (index = 0; index < filter->history.size; index++) {
+            writeCircBuf(&filter->history, initial);
+        }
+        filter->sum = initial * config->coefficients[0];
+        break;
+    case FILTER_IIR1:
+    case FILTER_IIR2:
+        filter->inputs[0] = filter->inputs[1] = initial;
+        filter->outputsQ[0] = filter->outputsQ[1] = initial << FILTER_Q_BITS;
+        break;
+    case FILTER_CIC:
+        // The integrators start from 0, so the output holds until the combs are full
+        filter->settling = config->coefficients[1];
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+//*******************************************************************************************
+// @param filter A FILTER_MEDIAN filter
+//
+// @return int32_t The middle of its history
+//*******************************************************************************************
+static int32_t
+medianOf(const filter_t *filter)
+{
+    int32_t sorted[FILTER_MAX_MEDIAN];
+    int32_t value;
+    uint32_t width = filter->history.size;
+    uint32_t i;
+    uint32_t j;
+
+    // Insertion sort, quickest for so few
+    for (i = 0; i < width; i++) {
+        value = filter->history.data[i];
+        for (j = i; j > 0 && sorted[j - 1] > value; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+    }
+    return sorted[width / 2];
+}
+
+//*******************************************************************************************
+// @param filter A FILTER_CIC filter
+//
+// @param sample The next sample
+//
+// Integrates every sample and combs every decimation samples. Integrator overflow wraps
+// and the combs take it out again, so the output is exact while it fits in 32 bits.
+//*******************************************************************************************
+static void
+runCic(filter_t *filter, int32_t sample)
+{
+    uint32_t value = sample;
+    uint32_t delayed;
+    uint32_t gain;
+    int32_t stage;
+    int32_t order = filter->config.coefficients[1];
+
+    for (stage = 0; stage < order; stage++) {
+        filter->integrators[stage] += value;
+        value = filter->integrators[stage];
+    }
+    filter->phase++;
+    if (filter->phase < (uint32_t)filter->config.coefficients[0]) {
+        return;
+    }
+    filter->phase = 0;
+    for (stage = 0; stage < order; stage++) {
+        delayed = filter->combs[stage];
+        filter->combs[stage] = value;
+        value -= delayed;
+    }
+    if (filter->settling > 0) {
+        filter->settling--;
+        return;
+    }
+    gain = cicGain(&filter->config);
+    filter->output = (value + gain / 2) / gain;
+}
+
+//*******************************************************************************************
+// @param filter Filter to run
+//
+// @param sample The next sample, 0 to 65535
+//
+// @return int32_t The filter output after this sample, also kept in filter->output
+//*******************************************************************************************
+int32_t
+runFilter(filter_t *filter, int32_t sample)
+{
+    const int32_t *c = filter->config.coefficients;
+    int64_t accumulator;
+
+    switch (filter->config.type) {
+    case FILTER_BOXCAR:
+        // The history is always full, so the write index holds the oldest sample,
+        // which leaves the running sum as the new one joins it
+        filter->sum += sample - (int32_t)filter->history.data[filter->history.windex];
+        writeCircBuf(&filter->history, sample);
+        // Rounded mean
+        filter->output = (2 * filter->sum + c[0]) / 2 / c[0];
+        break;
+    case FILTER_IIR1:
+        filter->outputsQ[0] += ((int64_t)c[0]
+                                * (((int32_t)sample << FILTER_Q_BITS) - filter->outputsQ[0]))
+                               >> FILTER_Q_BITS;
+        filter->output = (filter->outputsQ[0] + FILTER_ONE / 2) >> FILTER_Q_BITS;
+        break;
+    case FILTER_IIR2:
+        accumulator = (int64_t)c[0] * sample + (int64_t)c[1] * filter->inputs[0]
+                      + (int64_t)c[2] * filter->inputs[1]
+                      - (((int64_t)c[3] * filter->outputsQ[0]
+                          + (int64_t)c[4] * filter->outputsQ[1]) >> FILTER_Q_BITS);
+        filter->inputs[1] = filter->inputs[0];
+        filter->inputs[0] = sample;
+        filter->outputsQ[1] = filter->outputsQ[0];
+        filter->outputsQ[0] = (int32_t)accumulator;
+        filter->output = (filter->outputsQ[0] + FILTER_ONE / 2) >> FILTER_Q_BITS;
+        break;
+    case FILTER_CIC:
+        runCic(filter, sample);
+        break;
+    case FILTER_MEDIAN:
+        writeCircBuf(&filter->history, sample);
+        filter->output = medianOf(filter);
+        break;
+    default:
+        filter->output = sample;
+        break;
+    }
+    return filter->output;
+}
+
+//*******************************************************************************************
+// @param config The filter and its coefficients, already checked
+//
+// @return int32_t Samples a slowly changing input takes to reach the output, with
+// FILTER_DELAY_Q_BITS fraction bits
+//
+// The group delay at DC. A median has no such thing, so it is given the delay of the
+// boxcar of its width, which it matches on a ramp.
+//*******************************************************************************************
+int32_t
+getFilterDelay(const filterConfig_t *config)
+{
+    const int32_t *c = config->coefficients;
+
+    switch (config->type) {
+    case FILTER_BOXCAR:
+    case FILTER_MEDIAN:
+        return ((c[0] - 1) << FILTER_DELAY_Q_BITS) / 2;
+    case FILTER_IIR1:
+        return ((int64_t)(FILTER_ONE - c[0]) << FILTER_DELAY_Q_BITS) / c[0];
+    case FILTER_IIR2:
+        // Centre of the numerator less that of the denominator, whose sums are equal
+        return ((int64_t)(c[1] + 2 * c[2] - c[3] - 2 * c[4]) << FILTER_DELAY_Q_BITS)
+               / (c[0] + c[1] + c[2]);
+    case FILTER_CIC:
+        // The combs, then holding each output for decimation samples
+        return ((c[1] + 1) * (c[0] - 1) << FILTER_DELAY_Q_BITS) / 2;
+    default:
+        return 0;
+    }
+}
+
+//*******************************************************************************************
+// @param type A filter
+//
+// @return uint32_t The number of coefficients it takes
+//*******************************************************************************************
+uint32_t
+filterCoefficientCount(filterType_t type)
+{
+    return type < NUM_FILTER_TYPES ? coefficientCounts[type] : 0;
+}
+
+//*******************************************************************************************
+// @param type A filter
+//
+// @return const char* Its name, as filterFromName() takes
+//*******************************************************************************************
+const char *
+filterName(filterType_t type)
+{
+    return type < NUM_FILTER_TYPES ? filterNames[type] : "";
+}
+
+//*******************************************************************************************
+// @param name Text starting with a filter name, ended by a space or the end of the text
+//
+// @param type Set to the filter named
+//
+// @return size_t Length of the name, 0 if no filter has it
+//*******************************************************************************************
+size_t
+filterFromName(const char *name, filterType_t *type)
+{
+    size_t index;
+    size_t length;
+
+    for (index = 0; index < NUM_FILTER_TYPES; index++) {
+        length = ustrlen(filterNames[index]);
+        if (ustrncmp(name, filterNames[index], length) == 0
+                && (name[length] == ' ' || name[length] == '\0')) {
+            *type = (filterType_t)index;
+            return length;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * filters.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the digital filter library. Each filter_t runs one
+ *      of a handful of low-pass filters a sample at a time in integer arithmetic only,
+ *      so it is cheap enough for an interrupt handler. The filter and its coefficients
+ *      are given by a filterConfig_t, so one can be swapped for another at run time.
+ */
+
+#ifndef FILTERS_H_
+#define FILTERS_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "circBufT.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+// IIR coefficients and state are fixed point with FILTER_Q_BITS fraction bits
+#define FILTER_Q_BITS 14
+#define FILTER_ONE (1 << FILTER_Q_BITS)
+#define FILTER_COEFFICIENTS 5
+#define FILTER_MAX_TAPS 64          // Longest boxcar
+#define FILTER_MAX_MEDIAN 9         // Widest median, which must be odd, up to FILTER_MAX_TAPS
+#define FILTER_MAX_DECIMATION 16
+#define FILTER_MAX_CIC_ORDER 4
+// getFilterDelay() gives samples with FILTER_DELAY_Q_BITS fraction bits
+#define FILTER_DELAY_Q_BITS 8
+
+//*******************************************************************************************
+// Types
+//*******************************************************************************************
+// The coefficients each filter takes, in order, are:
+//  FILTER_BOXCAR   taps, the mean of the last 1 to FILTER_MAX_TAPS samples
+//  FILTER_IIR1     alpha, the share of each new sample in Q FILTER_Q_BITS, 1 to FILTER_ONE
+//  FILTER_IIR2     b0, b1, b2, a1, a2 of the biquad y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2,
+//                  in Q FILTER_Q_BITS. b0 + b1 + b2 must be FILTER_ONE + a1 + a2, for
+//                  unity gain at DC.
+//  FILTER_CIC      decimation, 1 to FILTER_MAX_DECIMATION, then order, 1 to
+//                  FILTER_MAX_CIC_ORDER. The output changes once per decimation samples.
+//  FILTER_MEDIAN   width, an odd number of samples up to FILTER_MAX_MEDIAN
+typedef enum {
+    FILTER_BOXCAR = 0,
+    FILTER_IIR1,
+    FILTER_IIR2,
+    FILTER_CIC,
+    FILTER_MEDIAN,
+    NUM_FILTER_TYPES
+} filterType_t;
+
+typedef struct {
+    filterType_t type;
+    int32_t coefficients[FILTER_COEFFICIENTS];
+} filterConfig_t;
+
+typedef struct {
+    filterConfig_t config;
+    circBuf_t history;              // Last samples, for the boxcar and median
+    uint32_t historyData[FILTER_MAX_TAPS];  // Where history keeps them, a median fits too
+    int32_t sum;                    // Boxcar sum of history
+    int32_t inputs[2];              // IIR2 x1, x2
+    int32_t outputsQ[2];            // IIR y1, y2 in Q FILTER_Q_BITS
+    uint32_t integrators[FILTER_MAX_CIC_ORDER];  // CIC, left to wrap as they will
+    uint32_t combs[FILTER_MAX_CIC_ORDER];        // CIC comb delays
+    uint32_t phase;                 // CIC samples since its last output
+    uint32_t settling;              // CIC outputs before its combs are full
+    int32_t output;
+} filter_t;
+
+//*******************************************************************************************
+// @param config The filter and its coefficients
+//
+// @return bool False if the coefficients are out of the ranges filterType_t gives
+//*******************************************************************************************
+bool
+checkFilterConfig(const filterConfig_t *config);
+
+//*******************************************************************************************
+// @param filter Filter to set up
+//
+// @param config The filter and its coefficients
+//
+// @param initial Output to start from, as if every sample so far had been this
+//
+// @return bool False if the coefficients are not valid, leaving the filter unusable
+//
+// Allocates nothing, so a filter can be set up again in place at any time.
+//*******************************************************************************************
+bool
+initFilter(filter_t *filter, const filterConfig_t *config, int32_t initial);
+
+//*******************************************************************************************
+// @param filter Filter to run
+//
+// @param sample The next sample, 0 to 65535
+//
+// @return int32_t The filter output after this sample, also kept in filter->output
+//*******************************************************************************************
+int32_t
+runFilter(filter_t *filter, int32_t sample);
+
+//*******************************************************************************************
+// @param config The filter and its coefficients, already checked
+//
+// @return int32_t Samples a slowly changing input takes to reach the output, with
+// FILTER_DELAY_Q_BITS fraction bits
+//*******************************************************************************************
+int32_t
+getFilterDelay(const filterConfig_t *config);
+
+//*******************************************************************************************
+// @param type A filter
+//
+// @return uint32_t The number of coefficients it takes
+//*******************************************************************************************
+uint32_t
+filterCoefficientCount(filterType_t type);
+
+//*******************************************************************************************
+// @param type A filter
+//
+// @return const char* Its name, as filterFromName() takes
+//*******************************************************************************************
+const char *
+filterName(filterType_t type);
+
+//*******************************************************************************************
+// @param name Text starting with a filter name, ended by a space or the end of the text
+//
+// @param type Set to the filter named
+//
+// @return size_t Length of the name, 0 if no filter has it
+//*******************************************************************************************
+size_t
+filterFromName(const char *name, filterType_t *type);
+
+#endif /* FILTERS_H_ */
@@ -33,17 +33,14 @@
 #include "pidController.h"
 #include "display.h"
 #include "scheduler.h"
+#include "profiler.h"
+#include "cpuLoad.h"
 #include "switches.h"
 #include "uartHeli.h"
-
-//*****************************************************************************
-// Constants
-//*****************************************************************************
-#define CONTROL_SCHEDULER_RATE SYSTICK_RATE_HZ / 15
-#define BUTTON_SCHEDULER_RATE SYSTICK_RATE_HZ / 30
-#define DISPLAY_SCHEDULER_RATE SYSTICK_RATE_HZ / 10
-#define STATE_MACHINE_SCHEDULER_RATE SYSTICK_RATE_HZ / 15
-#define UART_SCHEDULER_RATE SYSTICK_RATE_HZ / 2
+#include "schedulability.h"
+#include "hardTier.h"
+#include "timeBase.h"
+#include "sensors.h"
 
 /*************************************************************
  * SysTick interrupt
@@ -70,11 +67,14 @@ initSysTick (void)
 int
 main(void)
 {
+    char bootString[UART_VAL_LEN];
+
     // Disable interrupts to prevent initialisations being disrupted by interrupts
     // Prevent uninitialised interrupts from occurring
     IntMasterDisable();
     //Initialisations
     initClock();
+    initTimeBase();
     initSwitch();
     setState(LANDED);
     initUart();
@@ -84,20 +84,36 @@ main(void)
     initButtons ();
     initialisePWM ();
     initDisplay ();
-    initialiseTaskList();
+    initScheduler();
+    initEventQueue();
+    setEventHandler(EVENT_BUTTON, buttonEventHandler);
+    setEventHandler(EVENT_SWITCH, switchEventHandler);
+    setEventHandler(EVENT_REFERENCE, referenceEventHandler);
+    setEventHandler(EVENT_UART_RX, commandEventHandler);
+    initProfiler();
+    initCpuLoad();
     interruptSetQuadratureEncoder();
     interruptSetReference();
-    initialiseTask(updateControl, CONTROL_SCHEDULER_RATE, 0);
-    initialiseTask(checkButtonState, BUTTON_SCHEDULER_RATE, 1);
-    initialiseTask(displaySchedulerFunc, DISPLAY_SCHEDULER_RATE, 2);
-    initialiseTask(stateMachine, STATE_MACHINE_SCHEDULER_RATE, 3);
-    initialiseTask(updateUART, UART_SCHEDULER_RATE, 4);
+    initHardTier();
+    // Spread the releases so as few tasks as possible are made ready on the same tick
+    usprintf(bootString, "Worst tick load %d tasks\r\n", assignTaskPhases());
+    UARTSend(bootString);
+#if SCHEDULE_CHECK_AT_BOOT
+    // Reports any task whose budget could miss its deadline before the helicopter flies
+    checkSchedule(UARTSend);
+#endif
+    // The boot above is longer than the uDMA blocks, so sampling only starts now
+    startADC();
     IntMasterEnable();
 
     SysCtlDelay (SysCtlClockGet()/8); // Delay to allow crystal to settle for three cycles
     initialiseAdcValue();
+    updateSensors();
 
+    // The control law starts once the altitude has its reference
+    startHardTier();
     startScheduler();
+    return 0;   // Not reached, the scheduler never returns
 }
 
 
@@ -0,0 +1,111 @@
+/*
+ * hardTier.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Module runs the hard real-time tier from a periodic general purpose
+ *      timer. The timer reloads at exactly HARD_TIER_RATE_HZ whatever the background tier
+ *      is doing, and its interrupt outranks every other handler, so a hard task is only
+ *      held off by interrupts masked in a critical section. The timer counts down from its
+ *      load value after each reload, so the count at entry gives the latency of every tick,
+ *      which is the jitter of the tier.
+ */
+
+#include "hardTier.h"
+#include "profiler.h"
+#include "adcDma.h"
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+static uint32_t overruns;
+
+// Every other handler, dropped below the tier
+static const uint32_t backgroundInterrupts[] = {
+    FAULT_SYSTICK, ADC_ALTITUDE_INT, ADC_DMA_INT, INT_GPIOB, INT_GPIOC, INT_UART0
+};
+
+//*******************************************************************************************
+// Sets up the tier timer and its interrupt, and drops every other handler below it. Call
+// with interrupts masked, after the other handlers are set up.
+//*******************************************************************************************
+void
+initHardTier(void)
+{
+    size_t index;
+
+    SysCtlPeripheralEnable(HARD_TIER_PERIPH);
+    TimerConfigure(HARD_TIER_BASE, TIMER_CFG_PERIODIC);
+    TimerLoadSet(HARD_TIER_BASE, TIMER_A, SysCtlClockGet() / HARD_TIER_RATE_HZ - 1);
+    TimerIntRegister(HARD_TIER_BASE, TIMER_A, HardTierIntHandler);
+    TimerIntEnable(HARD_TIER_BASE, TIMER_TIMA_TIMEOUT);
+    IntPrioritySet(HARD_TIER_INT, HARD_TIER_INT_PRIORITY);
+    for (index = 0; index < sizeof(backgroundInterrupts) / sizeof(backgroundInterrupts[0]);
+            index++) {
+        IntPrioritySet(backgroundInterrupts[index], BACKGROUND_INT_PRIORITY);
+    }
+    overruns = 0;
+}
+
+//*******************************************************************************************
+// Starts the tier timer. Call once the sensors have their first readings, just before
+// startScheduler().
+//*******************************************************************************************
+void
+startHardTier(void)
+{
+    TimerEnable(HARD_TIER_BASE, TIMER_A);
+}
+
+//*******************************************************************************************
+// Runs the hard tier tasks that are due and measures the tier's jitter from the timer
+//*******************************************************************************************
+void
+HardTierIntHandler(void)
+{
+    // The timer reloaded when the interrupt was raised, so its count since is the latency
+    uint32_t latencyCycles = TimerLoadGet(HARD_TIER_BASE, TIMER_A)
+                             - TimerValueGet(HARD_TIER_BASE, TIMER_A);
+    uint32_t startCycles = isrEnter(ISR_HARD_TIER, latencyCycles);
+
+    TimerIntClear(HARD_TIER_BASE, TIMER_TIMA_TIMEOUT);
+    runHardTasks(startCycles - latencyCycles);
+    // A timeout while the tasks ran means the next tick starts late
+    if (TimerIntStatus(HARD_TIER_BASE, false) & TIMER_TIMA_TIMEOUT) {
+        overruns++;
+    }
+    isrExit(ISR_HARD_TIER, startCycles);
+}
+
+//*******************************************************************************************
+// @return bool Whether the tier was unlocked, to pass to unlockHardTier()
+//
+// Holds off the hard tier, leaving every other interrupt enabled. A timer tick that comes
+// meanwhile runs as soon as the tier is unlocked. Nests, and may be called from any tier.
+//*******************************************************************************************
+bool
+lockHardTier(void)
+{
+    bool wasUnlocked = IntIsEnabled(HARD_TIER_INT) != 0;
+    IntDisable(HARD_TIER_INT);
+    return wasUnlocked;
+}
+
+//*******************************************************************************************
+// @param wasUnlocked The value lockHardTier() returned
+//*******************************************************************************************
+void
+unlockHardTier(bool wasUnlocked)
+{
+    if (wasUnlocked) {
+        IntEnable(HARD_TIER_INT);
+    }
+}
+
+//*******************************************************************************************
+// @return uint32_t Timer ticks that came while the tier was still running the last one
+//*******************************************************************************************
+uint32_t
+getHardTierOverruns(void)
+{
+    return overruns;
+}
@@ -0,0 +1,83 @@
+/*
+ * hardTier.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the hard real-time tier. Tasks declared TIER_HARD in
+ *      tasks.h run inside a dedicated timer interrupt at the highest interrupt priority, so
+ *      their rate does not depend on how long the background tasks take. Data the tiers
+ *      share is written from the background under lockHardTier().
+ */
+
+#ifndef HARDTIER_H_
+#define HARDTIER_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/interrupt.h"
+#include "scheduler.h"
+#include "pwm.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+// Tier ticks per second. The same as SysTick, so a task rate divides both tiers alike and
+// can move between them or be changed by setTaskRate() either way.
+#define HARD_TIER_RATE_HZ SYSTICK_RATE_HZ
+#define HARD_TIER_PERIPH SYSCTL_PERIPH_TIMER2
+#define HARD_TIER_BASE TIMER2_BASE
+#define HARD_TIER_INT INT_TIMER2A
+
+// Interrupt priorities in the upper three bits, lower is more urgent. The hard tier
+// preempts every other handler.
+#define HARD_TIER_INT_PRIORITY 0x00
+#define BACKGROUND_INT_PRIORITY 0x20
+
+//*******************************************************************************************
+// Sets up the tier timer and its interrupt, and drops every other handler below it. Call
+// with interrupts masked, after the other handlers are set up.
+//*******************************************************************************************
+void
+initHardTier(void);
+
+//*******************************************************************************************
+// Starts the tier timer. Call once the sensors have their first readings, just before
+// startScheduler().
+//*******************************************************************************************
+void
+startHardTier(void);
+
+//*******************************************************************************************
+// Runs the hard tier tasks that are due and measures the tier's jitter from the timer
+//*******************************************************************************************
+void
+HardTierIntHandler(void);
+
+//*******************************************************************************************
+// @return bool Whether the tier was unlocked, to pass to unlockHardTier()
+//
+// Holds off the hard tier, leaving every other interrupt enabled. A timer tick that comes
+// meanwhile runs as soon as the tier is unlocked. Nests, and may be called from any tier.
+//*******************************************************************************************
+bool
+lockHardTier(void);
+
+//*******************************************************************************************
+// @param wasUnlocked The value lockHardTier() returned
+//*******************************************************************************************
+void
+unlockHardTier(bool wasUnlocked);
+
+//*******************************************************************************************
+// @return uint32_t Timer ticks that came while the tier was still running the last one
+//*******************************************************************************************
+uint32_t
+getHardTierOverruns(void);
+
+#endif /* HARDTIER_H_ */
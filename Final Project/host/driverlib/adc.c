@@ -0,0 +1,415 @@
+/*
+ * adc.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare ADC driver. Models the four sample
+ *      sequencers of ADC0 and ADC1 converting the voltages set by the simulated rig.
+ *      Every conversion adds the converter's own noise, from a generator that restarts
+ *      with each run, so a replay that presents the same voltages converts the same
+ *      codes. The hardware averager sums 2 to 64 conversions into each step and shifts
+ *      the sum down, as the Tiva's does, which is what takes that noise out. A sequence
+ *      with uDMA enabled offers each result to its channel as it converts, and raises
+ *      its interrupt when a transfer finishes rather than per sample.
+ */
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "driverlib/adc.h"
+#include "sim/simCore.h"
+#include "sim/simHardware.h"
+#include "sim/simTrace.h"
+#include "sim/simPeripherals.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define NUM_ADCS 2
+#define NUM_SEQUENCES 4
+#define MAX_STEPS 8
+#define NUM_CHANNELS 12
+#define CHANNEL_MASK 0xF
+#define ADC_MAX_CODE 4095
+#define ADC_REF_VOLTAGE 3.3
+#define INT_ADC1SS0 64
+#define UDMA_ADC0_CHANNEL 14    // Channel of sequence 0, each sequence after is the next
+#define UDMA_ADC1_CHANNEL 24
+#define INT_DMA_SHIFT 8         // ADC_INT_DMA_SSn is ADC_INT_SSn shifted up
+#define ADC_NOISE_CODES 2.0     // Peak converter noise, uniform
+#define MAX_OVERSAMPLE_SHIFT 6  // Averages up to 64 conversions
+
+//*****************************************************************************
+// Structs
+//*****************************************************************************
+typedef struct {
+    uint32_t trigger;
+    uint32_t steps[MAX_STEPS];
+    uint32_t fifo[MAX_STEPS];
+    uint32_t fifoCount;
+    bool enabled;
+    bool intMask;
+    bool intRaw;
+    bool dmaEnabled;
+    bool dmaIntMask;
+    bool dmaIntRaw;     // A uDMA transfer from the sequence finished
+} adcSequence_t;
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static adcSequence_t sequences[NUM_ADCS][NUM_SEQUENCES];
+static double voltages[NUM_CHANNELS];
+static const uint32_t sequenceDepth[NUM_SEQUENCES] = {8, 4, 4, 1};
+static uint32_t oversampleShift[NUM_ADCS];  // log2 of the conversions averaged per step
+static uint32_t noiseState = 1;
+
+//*****************************************************************************
+// @return double Uniform noise in [-1, 1] from a xorshift generator
+//*****************************************************************************
+static double
+noise(void)
+{
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    return (double)noiseState / UINT32_MAX * 2.0 - 1.0;
+}
+
+//*****************************************************************************
+// @return adcSequence_t* The sample sequencer for the base and sequence number
+//*****************************************************************************
+static adcSequence_t *
+getSequence(uint32_t base, uint32_t sequenceNum)
+{
+    return &sequences[base == ADC1_BASE ? 1 : 0][sequenceNum & (NUM_SEQUENCES - 1)];
+}
+
+//*****************************************************************************
+// @return uint32_t The exception number of the sequence interrupt
+//*****************************************************************************
+static uint32_t
+getIntNum(uint32_t base, uint32_t sequenceNum)
+{
+    return (base == ADC1_BASE ? INT_ADC1SS0 : INT_ADC0SS0) + sequenceNum;
+}
+
+//*****************************************************************************
+// @return uint32_t The 12-bit conversion of the voltage on a channel, noise included
+//*****************************************************************************
+static uint32_t
+convert(uint32_t channel)
+{
+    double code = voltages[channel % NUM_CHANNELS] / ADC_REF_VOLTAGE * ADC_MAX_CODE
+                  + ADC_NOISE_CODES * noise() + 0.5;
+    if (code < 0) {
+        code = 0;
+    } else if (code > ADC_MAX_CODE) {
+        code = ADC_MAX_CODE;
+    }
+    return (uint32_t)code;
+}
+
+//*****************************************************************************
+// @return uint32_t A step's result, averaged by the hardware averager if it is on
+//*****************************************************************************
+static uint32_t
+convertStep(uint32_t base, uint32_t channel)
+{
+    uint32_t shift = oversampleShift[base == ADC1_BASE ? 1 : 0];
+    uint32_t sum = 0;
+    uint32_t i;
+
+    simTraceAdc(channel % NUM_CHANNELS, voltages[channel % NUM_CHANNELS]);
+    for (i = 0; i < (1u << shift); i++) {
+        sum += convert(channel);
+    }
+    return sum >> shift;
+}
+
+//*****************************************************************************
+// Offers the FIFO of a sequence to its uDMA channel, oldest result first, keeping
+// whatever the channel refuses
+//*****************************************************************************
+static void
+offerDma(uint32_t base, uint32_t sequenceNum)
+{
+    adcSequence_t *sequence = getSequence(base, sequenceNum);
+    uint32_t channel = (base == ADC1_BASE ? UDMA_ADC1_CHANNEL : UDMA_ADC0_CHANNEL) + sequenceNum;
+    uint32_t moved = 0;
+    uint32_t i;
+
+    while (moved < sequence->fifoCount) {
+        simUdmaResult_t result = simUdmaRequest(channel, sequence->fifo[moved]);
+        if (result == SIM_UDMA_REFUSED) {
+            break;
+        }
+        moved++;
+        if (result == SIM_UDMA_DONE) {
+            sequence->dmaIntRaw = true;
+        }
+    }
+    for (i = moved; i < sequence->fifoCount; i++) {
+        sequence->fifo[i - moved] = sequence->fifo[i];
+    }
+    sequence->fifoCount -= moved;
+}
+
+//*****************************************************************************
+// Runs every step of a sequence into its FIFO and raises the interrupt for any
+// step configured with ADC_CTL_IE
+//*****************************************************************************
+static void
+runSequence(uint32_t base, uint32_t sequenceNum)
+{
+    adcSequence_t *sequence = getSequence(base, sequenceNum);
+    uint32_t step;
+    if (!sequence->enabled) {
+        return;
+    }
+    for (step = 0; step < sequenceDepth[sequenceNum]; step++) {
+        uint32_t config = sequence->steps[step];
+        if (sequence->fifoCount < sequenceDepth[sequenceNum]) {
+            sequence->fifo[sequence->fifoCount++] = convertStep(base, config & CHANNEL_MASK);
+        }
+        if (config & ADC_CTL_IE) {
+            sequence->intRaw = true;
+        }
+        if (config & ADC_CTL_END) {
+            break;
+        }
+    }
+    if (sequence->dmaEnabled) {
+        offerDma(base, sequenceNum);
+    }
+    if ((sequence->intRaw && sequence->intMask) || (sequence->dmaIntRaw && sequence->dmaIntMask)) {
+        simIntPend(getIntNum(base, sequenceNum));
+    }
+}
+
+//*****************************************************************************
+// Starts every enabled sequence waiting on a timer trigger
+//*****************************************************************************
+void
+simAdcTimerTrigger(void)
+{
+    uint32_t adc;
+    uint32_t sequenceNum;
+    for (adc = 0; adc < NUM_ADCS; adc++) {
+        for (sequenceNum = 0; sequenceNum < NUM_SEQUENCES; sequenceNum++) {
+            if (sequences[adc][sequenceNum].trigger == ADC_TRIGGER_TIMER) {
+                runSequence(adc ? ADC1_BASE : ADC0_BASE, sequenceNum);
+            }
+        }
+    }
+}
+
+void
+ADCSequenceConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                     uint32_t ui32Trigger, uint32_t ui32Priority)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getSequence(ui32Base, ui32SequenceNum)->trigger = ui32Trigger;
+}
+
+void
+ADCSequenceStepConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                         uint32_t ui32Step, uint32_t ui32Config)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getSequence(ui32Base, ui32SequenceNum)->steps[ui32Step % MAX_STEPS] = ui32Config;
+}
+
+void
+ADCSequenceEnable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getSequence(ui32Base, ui32SequenceNum)->enabled = true;
+}
+
+void
+ADCSequenceDisable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getSequence(ui32Base, ui32SequenceNum)->enabled = false;
+}
+
+void
+ADCProcessorTrigger(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simConsume(SIM_CALL_CYCLES);
+    if (getSequence(ui32Base, ui32SequenceNum)->trigger == ADC_TRIGGER_PROCESSOR) {
+        runSequence(ui32Base, ui32SequenceNum);
+    }
+}
+
+int32_t
+ADCSequenceDataGet(uint32_t ui32Base, uint32_t ui32SequenceNum, uint32_t *pui32Buffer)
+{
+    adcSequence_t *sequence = getSequence(ui32Base, ui32SequenceNum);
+    uint32_t i;
+    int32_t count = sequence->fifoCount;
+    simConsume(SIM_CALL_CYCLES);
+    for (i = 0; i < sequence->fifoCount; i++) {
+        pui32Buffer[i] = sequence->fifo[i];
+    }
+    sequence->fifoCount = 0;
+    return count;
+}
+
+void
+ADCSequenceDMAEnable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getSequence(ui32Base, ui32SequenceNum)->dmaEnabled = true;
+}
+
+void
+ADCSequenceDMADisable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getSequence(ui32Base, ui32SequenceNum)->dmaEnabled = false;
+}
+
+void
+ADCHardwareOversampleConfigure(uint32_t ui32Base, uint32_t ui32Factor)
+{
+    uint32_t shift = 0;
+    simConsume(SIM_CALL_CYCLES);
+    // 0 or 1 turn the averager off, otherwise a power of two up to 64
+    for (ui32Factor >>= 1; ui32Factor > 0 && shift < MAX_OVERSAMPLE_SHIFT; ui32Factor >>= 1) {
+        shift++;
+    }
+    oversampleShift[ui32Base == ADC1_BASE ? 1 : 0] = shift;
+}
+
+void
+ADCIntRegister(uint32_t ui32Base, uint32_t ui32SequenceNum, void (*pfnHandler)(void))
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntRegister(getIntNum(ui32Base, ui32SequenceNum), pfnHandler);
+    simIntEnable(getIntNum(ui32Base, ui32SequenceNum), true);
+}
+
+void
+ADCIntEnable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    adcSequence_t *sequence = getSequence(ui32Base, ui32SequenceNum);
+    simConsume(SIM_CALL_CYCLES);
+    // Enabling the interrupt also clears any outstanding one
+    sequence->intRaw = false;
+    sequence->intMask = true;
+}
+
+void
+ADCIntDisable(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getSequence(ui32Base, ui32SequenceNum)->intMask = false;
+}
+
+uint32_t
+ADCIntStatus(uint32_t ui32Base, uint32_t ui32SequenceNum, bool bMasked)
+{
+    adcSequence_t *sequence = getSequence(ui32Base, ui32SequenceNum);
+    simConsume(SIM_CALL_CYCLES);
+    return bMasked ? (sequence->intRaw && sequence->intMask) : sequence->intRaw;
+}
+
+void
+ADCIntClear(uint32_t ui32Base, uint32_t ui32SequenceNum)
+{
+    adcSequence_t *sequence = getSequence(ui32Base, ui32SequenceNum);
+    simConsume(SIM_CALL_CYCLES);
+    sequence->intRaw = false;
+    if (!(sequence->dmaIntRaw && sequence->dmaIntMask)) {
+        simIntUnpend(getIntNum(ui32Base, ui32SequenceNum));
+    }
+}
+
+void
+ADCIntEnableEx(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uint32_t sequenceNum;
+    simConsume(SIM_CALL_CYCLES);
+    for (sequenceNum = 0; sequenceNum < NUM_SEQUENCES; sequenceNum++) {
+        adcSequence_t *sequence = getSequence(ui32Base, sequenceNum);
+        if (ui32IntFlags & (ADC_INT_SS0 << sequenceNum)) {
+            sequence->intMask = true;
+        }
+        if (ui32IntFlags & (ADC_INT_DMA_SS0 << sequenceNum)) {
+            sequence->dmaIntMask = true;
+        }
+    }
+}
+
+void
+ADCIntDisableEx(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uint32_t sequenceNum;
+    simConsume(SIM_CALL_CYCLES);
+    for (sequenceNum = 0; sequenceNum < NUM_SEQUENCES; sequenceNum++) {
+        adcSequence_t *sequence = getSequence(ui32Base, sequenceNum);
+        if (ui32IntFlags & (ADC_INT_SS0 << sequenceNum)) {
+            sequence->intMask = false;
+        }
+        if (ui32IntFlags & (ADC_INT_DMA_SS0 << sequenceNum)) {
+            sequence->dmaIntMask = false;
+        }
+    }
+}
+
+uint32_t
+ADCIntStatusEx(uint32_t ui32Base, bool bMasked)
+{
+    uint32_t status = 0;
+    uint32_t sequenceNum;
+    simConsume(SIM_CALL_CYCLES);
+    for (sequenceNum = 0; sequenceNum < NUM_SEQUENCES; sequenceNum++) {
+        adcSequence_t *sequence = getSequence(ui32Base, sequenceNum);
+        if (sequence->intRaw && (!bMasked || sequence->intMask)) {
+            status |= ADC_INT_SS0 << sequenceNum;
+        }
+        if (sequence->dmaIntRaw && (!bMasked || sequence->dmaIntMask)) {
+            status |= ADC_INT_SS0 << (sequenceNum + INT_DMA_SHIFT);
+        }
+    }
+    return status;
+}
+
+void
+ADCIntClearEx(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    uint32_t sequenceNum;
+    simConsume(SIM_CALL_CYCLES);
+    for (sequenceNum = 0; sequenceNum < NUM_SEQUENCES; sequenceNum++) {
+        adcSequence_t *sequence = getSequence(ui32Base, sequenceNum);
+        if (ui32IntFlags & (ADC_INT_SS0 << sequenceNum)) {
+            sequence->intRaw = false;
+        }
+        if (ui32IntFlags & (ADC_INT_DMA_SS0 << sequenceNum)) {
+            sequence->dmaIntRaw = false;
+        }
+        if (!(sequence->intRaw && sequence->intMask)
+                && !(sequence->dmaIntRaw && sequence->dmaIntMask)) {
+            simIntUnpend(getIntNum(ui32Base, sequenceNum));
+        }
+    }
+}
+
+void
+simAdcSetVoltage(uint32_t channel, double volts)
+{
+    voltages[channel % NUM_CHANNELS] = volts;
+}
+
+void
+simAdcSetCode(uint32_t channel, uint32_t code)
+{
+    // The middle of the code's input range, so only the converter noise moves it
+    voltages[channel % NUM_CHANNELS] = code * ADC_REF_VOLTAGE / ADC_MAX_CODE;
+}
+
+double
+simAdcGetVoltage(uint32_t channel)
+{
+    return voltages[channel % NUM_CHANNELS];
+}
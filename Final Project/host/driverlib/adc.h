@@ -0,0 +1,79 @@
+/*
+ * adc.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare ADC driver. Models the four sample
+ *      sequencers of ADC0 and ADC1 converting the voltages set by the simulated rig, with
+ *      the converter's own noise on each conversion and the hardware averager. A
+ *      sequence can be started by a timer and hand its results to the uDMA.
+ */
+
+#ifndef __DRIVERLIB_ADC_H__
+#define __DRIVERLIB_ADC_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//*****************************************************************************
+// Trigger sources
+//*****************************************************************************
+#define ADC_TRIGGER_PROCESSOR   0x00000000
+#define ADC_TRIGGER_TIMER       0x00000005
+#define ADC_TRIGGER_ALWAYS      0x0000000F
+
+//*****************************************************************************
+// Step configuration
+//*****************************************************************************
+#define ADC_CTL_TS              0x00000080
+#define ADC_CTL_IE              0x00000040
+#define ADC_CTL_END             0x00000020
+#define ADC_CTL_D               0x00000010
+#define ADC_CTL_CH0             0x00000000
+#define ADC_CTL_CH1             0x00000001
+#define ADC_CTL_CH2             0x00000002
+#define ADC_CTL_CH3             0x00000003
+#define ADC_CTL_CH4             0x00000004
+#define ADC_CTL_CH5             0x00000005
+#define ADC_CTL_CH6             0x00000006
+#define ADC_CTL_CH7             0x00000007
+#define ADC_CTL_CH8             0x00000008
+#define ADC_CTL_CH9             0x00000009
+#define ADC_CTL_CH10            0x0000000A
+#define ADC_CTL_CH11            0x0000000B
+
+//*****************************************************************************
+// Interrupt sources for the Ex interrupt calls
+//*****************************************************************************
+#define ADC_INT_SS0             0x00000001
+#define ADC_INT_SS1             0x00000002
+#define ADC_INT_SS2             0x00000004
+#define ADC_INT_SS3             0x00000008
+#define ADC_INT_DMA_SS0         0x00000100
+#define ADC_INT_DMA_SS1         0x00000200
+#define ADC_INT_DMA_SS2         0x00000400
+#define ADC_INT_DMA_SS3         0x00000800
+
+void ADCSequenceConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                          uint32_t ui32Trigger, uint32_t ui32Priority);
+void ADCSequenceStepConfigure(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                              uint32_t ui32Step, uint32_t ui32Config);
+void ADCSequenceEnable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCSequenceDisable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCProcessorTrigger(uint32_t ui32Base, uint32_t ui32SequenceNum);
+int32_t ADCSequenceDataGet(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                           uint32_t *pui32Buffer);
+void ADCSequenceDMAEnable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCSequenceDMADisable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCHardwareOversampleConfigure(uint32_t ui32Base, uint32_t ui32Factor);
+void ADCIntRegister(uint32_t ui32Base, uint32_t ui32SequenceNum,
+                    void (*pfnHandler)(void));
+void ADCIntEnable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCIntDisable(uint32_t ui32Base, uint32_t ui32SequenceNum);
+uint32_t ADCIntStatus(uint32_t ui32Base, uint32_t ui32SequenceNum, bool bMasked);
+void ADCIntClear(uint32_t ui32Base, uint32_t ui32SequenceNum);
+void ADCIntEnableEx(uint32_t ui32Base, uint32_t ui32IntFlags);
+void ADCIntDisableEx(uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t ADCIntStatusEx(uint32_t ui32Base, bool bMasked);
+void ADCIntClearEx(uint32_t ui32Base, uint32_t ui32IntFlags);
+
+#endif /* __DRIVERLIB_ADC_H__ */
@@ -0,0 +1,36 @@
+/*
+ * cpu.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare CPU instruction wrappers. WFI jumps
+ *      the virtual clock straight to the next interrupt.
+ */
+
+#include "driverlib/cpu.h"
+#include "sim/simCore.h"
+
+uint32_t
+CPUcpsid(void)
+{
+    return simIntMasterSet(false);
+}
+
+uint32_t
+CPUcpsie(void)
+{
+    return simIntMasterSet(true);
+}
+
+uint32_t
+CPUprimask(void)
+{
+    bool wasDisabled = simIntMasterSet(false);
+    simIntMasterSet(!wasDisabled);
+    return wasDisabled;
+}
+
+void
+CPUwfi(void)
+{
+    simWaitForInterrupt();
+}
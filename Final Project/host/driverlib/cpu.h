@@ -0,0 +1,18 @@
+/*
+ * cpu.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare CPU instruction wrappers.
+ */
+
+#ifndef __DRIVERLIB_CPU_H__
+#define __DRIVERLIB_CPU_H__
+
+#include <stdint.h>
+
+uint32_t CPUcpsid(void);
+uint32_t CPUcpsie(void);
+uint32_t CPUprimask(void);
+void CPUwfi(void);
+
+#endif /* __DRIVERLIB_CPU_H__ */
@@ -0,0 +1,13 @@
+/*
+ * debug.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare debug macros.
+ */
+
+#ifndef __DRIVERLIB_DEBUG_H__
+#define __DRIVERLIB_DEBUG_H__
+
+#define ASSERT(expr)
+
+#endif /* __DRIVERLIB_DEBUG_H__ */
@@ -0,0 +1,271 @@
+/*
+ * gpio.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare GPIO driver. Models GPIO ports A-F
+ *      with pad pulls, outputs, pins driven by the simulated rig and edge interrupts.
+ */
+
+#include "inc/hw_memmap.h"
+#include "inc/hw_ints.h"
+#include "driverlib/gpio.h"
+#include "sim/simCore.h"
+#include "sim/simHardware.h"
+#include "sim/simTrace.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define NUM_PORTS 6
+
+//*****************************************************************************
+// Structs
+//*****************************************************************************
+typedef struct {
+    uint32_t base;
+    uint32_t intNum;
+    uint8_t dirOut;         // Pins configured as outputs
+    uint8_t outputs;        // Levels written by the firmware
+    uint8_t driven;         // Input pins driven by the simulated rig
+    uint8_t drivenLevels;   // Levels the rig drives them to
+    uint8_t pullUp;         // Pins with a weak pull-up
+    uint8_t intMask;        // GPIOIM
+    uint8_t intRaw;         // GPIORIS
+    uint8_t bothEdges;      // GPIOIBE
+    uint8_t risingEdge;     // GPIOIEV
+    uint8_t levelSense;     // GPIOIS
+} gpioPort_t;
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static gpioPort_t ports[NUM_PORTS] = {
+    {GPIO_PORTA_BASE, INT_GPIOA}, {GPIO_PORTB_BASE, INT_GPIOB},
+    {GPIO_PORTC_BASE, INT_GPIOC}, {GPIO_PORTD_BASE, INT_GPIOD},
+    {GPIO_PORTE_BASE, INT_GPIOE}, {GPIO_PORTF_BASE, INT_GPIOF},
+};
+
+//*****************************************************************************
+// @param base GPIO port base address
+//
+// @return gpioPort_t* The simulated port
+//*****************************************************************************
+static gpioPort_t *
+getPort(uint32_t base)
+{
+    int i;
+    for (i = 0; i < NUM_PORTS; i++) {
+        if (ports[i].base == base) {
+            return &ports[i];
+        }
+    }
+    return &ports[0];
+}
+
+//*****************************************************************************
+// @return uint8_t The electrical level of every pin on the port
+//*****************************************************************************
+static uint8_t
+portLevels(gpioPort_t *port)
+{
+    uint8_t inputs = (port->drivenLevels & port->driven) | (port->pullUp & ~port->driven);
+    return (port->outputs & port->dirOut) | (inputs & ~port->dirOut);
+}
+
+//*****************************************************************************
+// Latches edge interrupts for pins that changed level and pends the port
+// interrupt if any of them are unmasked
+//*****************************************************************************
+static void
+detectEdges(gpioPort_t *port, uint8_t before)
+{
+    uint8_t after = portLevels(port);
+    uint8_t changed = (before ^ after) & ~port->levelSense;
+    uint8_t rising = changed & after;
+    uint8_t falling = changed & ~after;
+    port->intRaw |= (changed & port->bothEdges)
+                  | (rising & port->risingEdge & ~port->bothEdges)
+                  | (falling & ~port->risingEdge & ~port->bothEdges);
+    if (port->intRaw & port->intMask) {
+        simIntPend(port->intNum);
+    }
+}
+
+void
+GPIODirModeSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32PinIO)
+{
+    gpioPort_t *port = getPort(ui32Port);
+    uint8_t before = portLevels(port);
+    simConsume(SIM_CALL_CYCLES);
+    if (ui32PinIO == GPIO_DIR_MODE_OUT) {
+        port->dirOut |= ui8Pins;
+    } else {
+        port->dirOut &= ~ui8Pins;
+    }
+    detectEdges(port, before);
+}
+
+void
+GPIOPadConfigSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32Strength,
+                 uint32_t ui32PadType)
+{
+    gpioPort_t *port = getPort(ui32Port);
+    uint8_t before = portLevels(port);
+    simConsume(SIM_CALL_CYCLES);
+    if (ui32PadType == GPIO_PIN_TYPE_STD_WPU) {
+        port->pullUp |= ui8Pins;
+    } else {
+        port->pullUp &= ~ui8Pins;
+    }
+    detectEdges(port, before);
+}
+
+void
+GPIOPinTypeGPIOInput(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIODirModeSet(ui32Port, ui8Pins, GPIO_DIR_MODE_IN);
+}
+
+void
+GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIODirModeSet(ui32Port, ui8Pins, GPIO_DIR_MODE_OUT);
+}
+
+void
+GPIOPinTypePWM(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIODirModeSet(ui32Port, ui8Pins, GPIO_DIR_MODE_HW);
+}
+
+void
+GPIOPinTypeSSI(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIODirModeSet(ui32Port, ui8Pins, GPIO_DIR_MODE_HW);
+}
+
+void
+GPIOPinTypeUART(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIODirModeSet(ui32Port, ui8Pins, GPIO_DIR_MODE_HW);
+}
+
+void
+GPIOPinTypeADC(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    GPIODirModeSet(ui32Port, ui8Pins, GPIO_DIR_MODE_HW);
+}
+
+void
+GPIOPinConfigure(uint32_t ui32PinConfig)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+int32_t
+GPIOPinRead(uint32_t ui32Port, uint8_t ui8Pins)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return portLevels(getPort(ui32Port)) & ui8Pins;
+}
+
+void
+GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    gpioPort_t *port = getPort(ui32Port);
+    simConsume(SIM_CALL_CYCLES);
+    port->outputs = (port->outputs & ~ui8Pins) | (ui8Val & ui8Pins);
+}
+
+void
+GPIOIntTypeSet(uint32_t ui32Port, uint8_t ui8Pins, uint32_t ui32IntType)
+{
+    gpioPort_t *port = getPort(ui32Port);
+    simConsume(SIM_CALL_CYCLES);
+    port->bothEdges = (ui32IntType & GPIO_BOTH_EDGES) ?
+            (port->bothEdges | ui8Pins) : (port->bothEdges & ~ui8Pins);
+    port->levelSense = (ui32IntType & GPIO_LOW_LEVEL) ?
+            (port->levelSense | ui8Pins) : (port->levelSense & ~ui8Pins);
+    port->risingEdge = (ui32IntType & GPIO_RISING_EDGE) ?
+            (port->risingEdge | ui8Pins) : (port->risingEdge & ~ui8Pins);
+}
+
+void
+GPIOIntEnable(uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    gpioPort_t *port = getPort(ui32Port);
+    simConsume(SIM_CALL_CYCLES);
+    port->intMask |= ui32IntFlags;
+    if (port->intRaw & port->intMask) {
+        simIntPend(port->intNum);
+    }
+}
+
+void
+GPIOIntDisable(uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getPort(ui32Port)->intMask &= ~ui32IntFlags;
+}
+
+uint32_t
+GPIOIntStatus(uint32_t ui32Port, bool bMasked)
+{
+    gpioPort_t *port = getPort(ui32Port);
+    simConsume(SIM_CALL_CYCLES);
+    return bMasked ? (port->intRaw & port->intMask) : port->intRaw;
+}
+
+void
+GPIOIntClear(uint32_t ui32Port, uint32_t ui32IntFlags)
+{
+    gpioPort_t *port = getPort(ui32Port);
+    simConsume(SIM_CALL_CYCLES);
+    port->intRaw &= ~ui32IntFlags;
+    if ((port->intRaw & port->intMask) == 0) {
+        simIntUnpend(port->intNum);
+    }
+}
+
+void
+GPIOIntRegister(uint32_t ui32Port, void (*pfnIntHandler)(void))
+{
+    gpioPort_t *port = getPort(ui32Port);
+    simConsume(SIM_CALL_CYCLES);
+    simIntRegister(port->intNum, pfnIntHandler);
+    simIntEnable(port->intNum, true);
+}
+
+void
+GPIOIntRegisterPin(uint32_t ui32Port, uint32_t ui32Pin, void (*pfnIntHandler)(void))
+{
+    // The TM4C123 has no per-pin GPIO vectors, so every pin shares the port vector
+    GPIOIntRegister(ui32Port, pfnIntHandler);
+}
+
+void
+simGpioDrive(uint32_t base, uint8_t pins, uint8_t levels)
+{
+    gpioPort_t *port = getPort(base);
+    uint8_t before = portLevels(port);
+    simTraceGpio(base, pins, levels, true);
+    port->driven |= pins;
+    port->drivenLevels = (port->drivenLevels & ~pins) | (levels & pins);
+    detectEdges(port, before);
+}
+
+void
+simGpioRelease(uint32_t base, uint8_t pins)
+{
+    gpioPort_t *port = getPort(base);
+    uint8_t before = portLevels(port);
+    simTraceGpio(base, pins, 0, false);
+    port->driven &= ~pins;
+    detectEdges(port, before);
+}
+
+uint8_t
+simGpioLevels(uint32_t base)
+{
+    return portLevels(getPort(base));
+}
@@ -0,0 +1,88 @@
+/*
+ * interrupt.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare interrupt controller driver, backed by
+ *      the simulator's NVIC model.
+ */
+
+#include <stddef.h>
+#include "driverlib/interrupt.h"
+#include "sim/simCore.h"
+
+bool
+IntMasterEnable(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return simIntMasterSet(true);
+}
+
+bool
+IntMasterDisable(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return simIntMasterSet(false);
+}
+
+void
+IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void))
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntRegister(ui32Interrupt, pfnHandler);
+}
+
+void
+IntUnregister(uint32_t ui32Interrupt)
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntRegister(ui32Interrupt, NULL);
+}
+
+void
+IntEnable(uint32_t ui32Interrupt)
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntEnable(ui32Interrupt, true);
+}
+
+void
+IntDisable(uint32_t ui32Interrupt)
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntEnable(ui32Interrupt, false);
+}
+
+uint32_t
+IntIsEnabled(uint32_t ui32Interrupt)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return simIntIsEnabled(ui32Interrupt);
+}
+
+void
+IntPrioritySet(uint32_t ui32Interrupt, uint8_t ui8Priority)
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntPrioritySet(ui32Interrupt, ui8Priority);
+}
+
+int32_t
+IntPriorityGet(uint32_t ui32Interrupt)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return simIntPriorityGet(ui32Interrupt);
+}
+
+void
+IntPendSet(uint32_t ui32Interrupt)
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntPend(ui32Interrupt);
+}
+
+void
+IntPendClear(uint32_t ui32Interrupt)
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntUnpend(ui32Interrupt);
+}
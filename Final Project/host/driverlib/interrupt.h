@@ -0,0 +1,27 @@
+/*
+ * interrupt.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare interrupt controller driver, backed by
+ *      the simulator's NVIC model.
+ */
+
+#ifndef __DRIVERLIB_INTERRUPT_H__
+#define __DRIVERLIB_INTERRUPT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+bool IntMasterEnable(void);
+bool IntMasterDisable(void);
+void IntRegister(uint32_t ui32Interrupt, void (*pfnHandler)(void));
+void IntUnregister(uint32_t ui32Interrupt);
+void IntEnable(uint32_t ui32Interrupt);
+void IntDisable(uint32_t ui32Interrupt);
+uint32_t IntIsEnabled(uint32_t ui32Interrupt);
+void IntPrioritySet(uint32_t ui32Interrupt, uint8_t ui8Priority);
+int32_t IntPriorityGet(uint32_t ui32Interrupt);
+void IntPendSet(uint32_t ui32Interrupt);
+void IntPendClear(uint32_t ui32Interrupt);
+
+#endif /* __DRIVERLIB_INTERRUPT_H__ */
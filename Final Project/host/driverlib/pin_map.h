@@ -0,0 +1,19 @@
+/*
+ * pin_map.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare pin map. Only the TM4C123GH6PM pin
+ *      functions used by the firmware are defined.
+ */
+
+#ifndef __DRIVERLIB_PIN_MAP_H__
+#define __DRIVERLIB_PIN_MAP_H__
+
+#define GPIO_PA0_U0RX           0x00000001
+#define GPIO_PA1_U0TX           0x00000401
+#define GPIO_PC5_M0PWM7         0x00021404
+#define GPIO_PF1_M1PWM5         0x00050405
+#define GPIO_PD0_SSI3CLK        0x00030001
+#define GPIO_PD3_SSI3TX         0x00030C01
+
+#endif /* __DRIVERLIB_PIN_MAP_H__ */
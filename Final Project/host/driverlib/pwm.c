@@ -0,0 +1,167 @@
+/*
+ * pwm.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare PWM driver. Models the four
+ *      generators of PWM0 and PWM1 so the simulated rig can read the motor duty cycles.
+ */
+
+#include "inc/hw_memmap.h"
+#include "driverlib/pwm.h"
+#include "sim/simCore.h"
+#include "sim/simHardware.h"
+#include "sim/simTrace.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define NUM_MODULES 2
+#define NUM_GENERATORS 4
+#define NUM_OUTPUTS 8
+#define GEN_SHIFT 6
+
+//*****************************************************************************
+// Structs
+//*****************************************************************************
+typedef struct {
+    uint32_t period[NUM_GENERATORS];
+    bool genEnabled[NUM_GENERATORS];
+    uint32_t width[NUM_OUTPUTS];
+    uint32_t outputEnabled;         // PWM_OUT_n_BIT mask
+    uint32_t tracedWidth[NUM_OUTPUTS];  // Waveform last reported to the output trace
+    uint32_t tracedPeriod[NUM_OUTPUTS];
+    bool tracedOn[NUM_OUTPUTS];
+} pwmModule_t;
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static pwmModule_t modules[NUM_MODULES];
+
+static pwmModule_t *
+getModule(uint32_t base)
+{
+    return &modules[base == PWM1_BASE ? 1 : 0];
+}
+
+//*****************************************************************************
+// @return uint32_t Generator index 0-3 from a PWM_GEN_n or PWM_OUT_n value
+//*****************************************************************************
+static uint32_t
+genIndex(uint32_t genOrOut)
+{
+    return ((genOrOut >> GEN_SHIFT) - 1) & (NUM_GENERATORS - 1);
+}
+
+//*****************************************************************************
+// @return uint32_t Output index 0-7 from a PWM_OUT_n value
+//*****************************************************************************
+static uint32_t
+outIndex(uint32_t out)
+{
+    return genIndex(out) * 2 + (out & 1);
+}
+
+//*****************************************************************************
+// Reports every output of the module whose waveform on the pin has changed
+//*****************************************************************************
+static void
+traceOutputs(uint32_t base)
+{
+    pwmModule_t *module = getModule(base);
+    uint32_t i;
+    for (i = 0; i < NUM_OUTPUTS; i++) {
+        bool on = (module->outputEnabled & (1u << i)) && module->genEnabled[i / 2];
+        uint32_t width = on ? module->width[i] : 0;
+        uint32_t period = on ? module->period[i / 2] : 0;
+        if (on != module->tracedOn[i] || width != module->tracedWidth[i]
+                || period != module->tracedPeriod[i]) {
+            module->tracedOn[i] = on;
+            module->tracedWidth[i] = width;
+            module->tracedPeriod[i] = period;
+            simTraceOutput("pwm %u %u %u %u", base == PWM1_BASE, i, width, period);
+        }
+    }
+}
+
+void
+PWMGenConfigure(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Config)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+void
+PWMGenPeriodSet(uint32_t ui32Base, uint32_t ui32Gen, uint32_t ui32Period)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getModule(ui32Base)->period[genIndex(ui32Gen)] = ui32Period;
+    traceOutputs(ui32Base);
+}
+
+uint32_t
+PWMGenPeriodGet(uint32_t ui32Base, uint32_t ui32Gen)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return getModule(ui32Base)->period[genIndex(ui32Gen)];
+}
+
+void
+PWMGenEnable(uint32_t ui32Base, uint32_t ui32Gen)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getModule(ui32Base)->genEnabled[genIndex(ui32Gen)] = true;
+    traceOutputs(ui32Base);
+}
+
+void
+PWMGenDisable(uint32_t ui32Base, uint32_t ui32Gen)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getModule(ui32Base)->genEnabled[genIndex(ui32Gen)] = false;
+    traceOutputs(ui32Base);
+}
+
+void
+PWMPulseWidthSet(uint32_t ui32Base, uint32_t ui32PWMOut, uint32_t ui32Width)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getModule(ui32Base)->width[outIndex(ui32PWMOut)] = ui32Width;
+    traceOutputs(ui32Base);
+}
+
+uint32_t
+PWMPulseWidthGet(uint32_t ui32Base, uint32_t ui32PWMOut)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return getModule(ui32Base)->width[outIndex(ui32PWMOut)];
+}
+
+void
+PWMOutputState(uint32_t ui32Base, uint32_t ui32PWMOutBits, bool bEnable)
+{
+    pwmModule_t *module = getModule(ui32Base);
+    simConsume(SIM_CALL_CYCLES);
+    if (bEnable) {
+        module->outputEnabled |= ui32PWMOutBits;
+    } else {
+        module->outputEnabled &= ~ui32PWMOutBits;
+    }
+    traceOutputs(ui32Base);
+}
+
+double
+simPwmDuty(uint32_t base, uint32_t out)
+{
+    pwmModule_t *module = getModule(base);
+    uint32_t gen = genIndex(out);
+    uint32_t index = outIndex(out);
+    if (!(module->outputEnabled & (1u << index)) || !module->genEnabled[gen]
+            || module->period[gen] == 0) {
+        return 0;
+    }
+    // A compare value past the load value never matches, leaving the pin high
+    if (module->width[index] >= module->period[gen]) {
+        return 100.0;
+    }
+    return 100.0 * module->width[index] / module->period[gen];
+}
@@ -0,0 +1,91 @@
+/*
+ * ssi.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare SSI driver. Models SSI3 driving the
+ *      Orbit OLED, with the bus busy for the time each frame takes to shift out.
+ */
+
+#include "driverlib/ssi.h"
+#include "sim/simCore.h"
+#include "sim/simHardware.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define SSI_FIFO_DEPTH 8
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static uint32_t frameCycles = 1;
+static uint64_t txDoneAt;
+static uint64_t framesSent;
+
+void
+SSIConfigSetExpClk(uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol,
+                   uint32_t ui32Mode, uint32_t ui32BitRate, uint32_t ui32DataWidth)
+{
+    simConsume(SIM_CALL_CYCLES);
+    frameCycles = (uint32_t)((uint64_t)ui32SSIClk * ui32DataWidth / ui32BitRate);
+    if (frameCycles == 0) {
+        frameCycles = 1;
+    }
+}
+
+void
+SSIClockSourceSet(uint32_t ui32Base, uint32_t ui32Source)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+void
+SSIEnable(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+void
+SSIDisable(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+bool
+SSIBusy(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return simCycles() < txDoneAt;
+}
+
+void
+SSIDataPut(uint32_t ui32Base, uint32_t ui32Data)
+{
+    uint64_t now;
+    simConsume(SIM_CALL_CYCLES);
+    now = simCycles();
+    // Block while the transmit FIFO is full
+    if (txDoneAt > now + (uint64_t)SSI_FIFO_DEPTH * frameCycles) {
+        simConsumeUntil(txDoneAt - (uint64_t)SSI_FIFO_DEPTH * frameCycles);
+        now = simCycles();
+    }
+    txDoneAt = (txDoneAt > now ? txDoneAt : now) + frameCycles;
+    framesSent++;
+}
+
+void
+SSIDataGet(uint32_t ui32Base, uint32_t *pui32Data)
+{
+    simConsume(SIM_CALL_CYCLES);
+    // Block until the frame clocked in alongside the last transmit has arrived
+    if (simCycles() < txDoneAt) {
+        simConsumeUntil(txDoneAt);
+    }
+    *pui32Data = 0;
+}
+
+uint64_t
+simSsiFramesSent(void)
+{
+    return framesSent;
+}
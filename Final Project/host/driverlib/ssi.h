@@ -0,0 +1,28 @@
+/*
+ * ssi.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare SSI driver. Models SSI3 driving the
+ *      Orbit OLED, with the bus busy for the time each frame takes to shift out.
+ */
+
+#ifndef __DRIVERLIB_SSI_H__
+#define __DRIVERLIB_SSI_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SSI_FRF_MOTO_MODE_0     0x00000000
+#define SSI_MODE_MASTER         0x00000000
+#define SSI_CLOCK_SYSTEM        0x00000000
+
+void SSIConfigSetExpClk(uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol,
+                        uint32_t ui32Mode, uint32_t ui32BitRate, uint32_t ui32DataWidth);
+void SSIClockSourceSet(uint32_t ui32Base, uint32_t ui32Source);
+void SSIEnable(uint32_t ui32Base);
+void SSIDisable(uint32_t ui32Base);
+bool SSIBusy(uint32_t ui32Base);
+void SSIDataPut(uint32_t ui32Base, uint32_t ui32Data);
+void SSIDataGet(uint32_t ui32Base, uint32_t *pui32Data);
+
+#endif /* __DRIVERLIB_SSI_H__ */
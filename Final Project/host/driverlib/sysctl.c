@@ -0,0 +1,115 @@
+/*
+ * sysctl.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare system control driver. Clock
+ *      configuration drives the simulator's virtual clock, delays advance it and a
+ *      reset ends the simulated run.
+ */
+
+#include "driverlib/sysctl.h"
+#include "sim/simCore.h"
+#include "sim/simHardware.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define PLL_CLOCK_HZ 200000000      // 400 MHz PLL output after the fixed /2
+#define SYSDIV_SHIFT 23
+#define SYSDIV_MASK 0xF
+#define PWMDIV_ENABLE 0x00100000
+#define PWMDIV_SHIFT 17
+#define PWMDIV_MASK 0x7
+#define DELAY_LOOP_CYCLES 3         // SysCtlDelay() runs a three cycle loop
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static uint32_t pwmClockConfig = SYSCTL_PWMDIV_1;
+
+void
+SysCtlClockSet(uint32_t ui32Config)
+{
+    simConsume(SIM_CALL_CYCLES);
+    if ((ui32Config & SYSCTL_USE_OSC) == SYSCTL_USE_OSC) {
+        simSetClockHz(SIM_DEFAULT_CLOCK_HZ);
+    } else {
+        simSetClockHz(PLL_CLOCK_HZ / (((ui32Config >> SYSDIV_SHIFT) & SYSDIV_MASK) + 1));
+    }
+}
+
+uint32_t
+SysCtlClockGet(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return simClockHz();
+}
+
+void
+SysCtlPWMClockSet(uint32_t ui32Config)
+{
+    simConsume(SIM_CALL_CYCLES);
+    pwmClockConfig = ui32Config;
+}
+
+uint32_t
+SysCtlPWMClockGet(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return pwmClockConfig;
+}
+
+//*****************************************************************************
+// @return uint32_t The divider between the system clock and the PWM clock
+//*****************************************************************************
+uint32_t
+simPwmClockDivider(void)
+{
+    if ((pwmClockConfig & PWMDIV_ENABLE) == 0) {
+        return 1;
+    }
+    return 2u << ((pwmClockConfig >> PWMDIV_SHIFT) & PWMDIV_MASK);
+}
+
+void
+SysCtlPeripheralEnable(uint32_t ui32Peripheral)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+void
+SysCtlPeripheralDisable(uint32_t ui32Peripheral)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+void
+SysCtlPeripheralReset(uint32_t ui32Peripheral)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+bool
+SysCtlPeripheralReady(uint32_t ui32Peripheral)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return true;
+}
+
+void
+SysCtlDelay(uint32_t ui32Count)
+{
+    simConsumeUntil(simCycles() + (uint64_t)ui32Count * DELAY_LOOP_CYCLES);
+}
+
+void
+SysCtlReset(void)
+{
+    simStop(SIM_STOP_RESET);
+}
+
+void
+SysCtlSleep(void)
+{
+    simWaitForInterrupt();
+}
@@ -0,0 +1,98 @@
+/*
+ * systick.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare SysTick driver. The counter is
+ *      derived from the virtual clock and the interrupt is a timed simulator event.
+ */
+
+#include "inc/hw_ints.h"
+#include "driverlib/systick.h"
+#include "sim/simCore.h"
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static uint32_t period = 1;
+static bool enabled;
+static uint64_t lastReload;         // Cycle count the counter last reloaded at
+static int reloadEvent = -1;
+
+//*****************************************************************************
+// Counter reached zero: reload it and raise the SysTick exception
+//*****************************************************************************
+static void
+reloadHandler(void)
+{
+    lastReload += period;
+    simEventAt(reloadEvent, lastReload + period);
+    simIntPend(FAULT_SYSTICK);
+}
+
+void
+SysTickEnable(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    if (reloadEvent < 0) {
+        reloadEvent = simEventRegister(reloadHandler);
+    }
+    enabled = true;
+    lastReload = simCycles();
+    simEventAt(reloadEvent, lastReload + period);
+}
+
+void
+SysTickDisable(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    enabled = false;
+    if (reloadEvent >= 0) {
+        simEventCancel(reloadEvent);
+    }
+}
+
+void
+SysTickIntRegister(void (*pfnHandler)(void))
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntRegister(FAULT_SYSTICK, pfnHandler);
+}
+
+void
+SysTickIntEnable(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntEnable(FAULT_SYSTICK, true);
+}
+
+void
+SysTickIntDisable(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntEnable(FAULT_SYSTICK, false);
+}
+
+void
+SysTickPeriodSet(uint32_t ui32Period)
+{
+    simConsume(SIM_CALL_CYCLES);
+    period = ui32Period;
+}
+
+uint32_t
+SysTickPeriodGet(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return period;
+}
+
+uint32_t
+SysTickValueGet(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    if (!enabled) {
+        return 0;
+    }
+    // The counter runs down from period - 1 to zero
+    return period - 1 - (uint32_t)((simCycles() - lastReload) % period);
+}
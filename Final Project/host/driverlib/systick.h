@@ -0,0 +1,23 @@
+/*
+ * systick.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare SysTick driver. The counter is
+ *      derived from the virtual clock and the interrupt is a timed simulator event.
+ */
+
+#ifndef __DRIVERLIB_SYSTICK_H__
+#define __DRIVERLIB_SYSTICK_H__
+
+#include <stdint.h>
+
+void SysTickEnable(void);
+void SysTickDisable(void);
+void SysTickIntRegister(void (*pfnHandler)(void));
+void SysTickIntEnable(void);
+void SysTickIntDisable(void);
+void SysTickPeriodSet(uint32_t ui32Period);
+uint32_t SysTickPeriodGet(void);
+uint32_t SysTickValueGet(void);
+
+#endif /* __DRIVERLIB_SYSTICK_H__ */
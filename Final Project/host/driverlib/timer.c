@@ -0,0 +1,299 @@
+/*
+ * timer.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare general purpose timer driver. Full
+ *      width timers count from the virtual clock; the OLED driver uses Timer 1 counting
+ *      up for its millisecond delays. A timer counting down raises its timeout interrupt
+ *      each time it reloads, from a timed simulator event, and can trigger the ADC then
+ *      too. Wide timers also count the full 64 bits, read with TimerValueGet64() only.
+ */
+
+#include <stddef.h>
+#include "inc/hw_ints.h"
+#include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_timer.h"
+#include "driverlib/timer.h"
+#include "sim/simCore.h"
+#include "sim/simPeripherals.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define NUM_TIMERS 8                // Timers 0 to 5, then wide timers 0 and 1
+#define TIMER_SPACING 0x1000
+#define TIMER_CFG_UP 0x00000010
+#define TIMER_CFG_MODE 0x0000000F
+#define TIMER_CFG_MODE_PERIODIC 0x00000002
+
+//*****************************************************************************
+// Structs
+//*****************************************************************************
+typedef struct {
+    uint32_t config;
+    uint32_t load;
+    bool enabled;
+    uint64_t lastSync;      // Cycle count the value register was last brought up to date
+    uint64_t nextTimeout;   // Cycle count of the next reload, counting down
+    uint32_t intMask;
+    uint32_t intStatus;
+    int timeoutEvent;
+    bool eventRegistered;
+    uint64_t load64;        // Full width load of a wide timer
+    uint64_t count64;       // Full width count at lastSync
+    bool adcTrigger;        // Each timeout triggers the ADC
+} gpTimer_t;
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static gpTimer_t timers[NUM_TIMERS];
+static const uint32_t intNums[NUM_TIMERS] = {
+    INT_TIMER0A, INT_TIMER1A, INT_TIMER2A, INT_TIMER3A,
+    INT_TIMER4A, INT_TIMER5A, INT_WTIMER0A, INT_WTIMER1A
+};
+
+static size_t
+timerNumber(uint32_t base)
+{
+    return ((base - TIMER0_BASE) / TIMER_SPACING) % NUM_TIMERS;
+}
+
+static gpTimer_t *
+getTimer(uint32_t base)
+{
+    return &timers[timerNumber(base)];
+}
+
+//*****************************************************************************
+// @param number Timer that reloaded
+//
+// Flags the timeout, raises its interrupt if enabled and schedules the next
+// reload of a periodic timer
+//*****************************************************************************
+static void
+timeout(size_t number)
+{
+    gpTimer_t *timer = &timers[number];
+    timer->intStatus |= TIMER_TIMA_TIMEOUT;
+    if (timer->intMask & TIMER_TIMA_TIMEOUT) {
+        simIntPend(intNums[number]);
+    }
+    if (timer->adcTrigger) {
+        simAdcTimerTrigger();
+    }
+    if ((timer->config & TIMER_CFG_MODE) == TIMER_CFG_MODE_PERIODIC) {
+        timer->nextTimeout += (uint64_t)timer->load + 1;
+        simEventAt(timer->timeoutEvent, timer->nextTimeout);
+    } else {
+        timer->enabled = false;
+    }
+}
+
+static void timeout0(void) { timeout(0); }
+static void timeout1(void) { timeout(1); }
+static void timeout2(void) { timeout(2); }
+static void timeout3(void) { timeout(3); }
+static void timeout4(void) { timeout(4); }
+static void timeout5(void) { timeout(5); }
+static void timeout6(void) { timeout(6); }
+static void timeout7(void) { timeout(7); }
+
+static void (*const timeoutHandlers[NUM_TIMERS])(void) = {
+    timeout0, timeout1, timeout2, timeout3, timeout4, timeout5, timeout6, timeout7
+};
+
+//*****************************************************************************
+// Schedules the next reload of a timer counting down, from the value it holds
+// now, if it is running with an interrupt or ADC trigger that needs it
+//*****************************************************************************
+static void
+scheduleTimeout(uint32_t base)
+{
+    gpTimer_t *timer = getTimer(base);
+    size_t number = timerNumber(base);
+    if (timer->enabled && !(timer->config & TIMER_CFG_UP)
+            && (timer->intMask != 0 || timer->adcTrigger)) {
+        if (!timer->eventRegistered) {
+            timer->timeoutEvent = simEventRegister(timeoutHandlers[number]);
+            timer->eventRegistered = true;
+        }
+        timer->nextTimeout = timer->lastSync + *simRegister(base + TIMER_O_TAV) + 1;
+        simEventAt(timer->timeoutEvent, timer->nextTimeout);
+    } else if (timer->eventRegistered) {
+        simEventCancel(timer->timeoutEvent);
+    }
+}
+
+//*****************************************************************************
+// Brings the shadow TAV register up to date with the virtual clock. Firmware may
+// write TAV directly through HWREG, so the elapsed time is added to whatever
+// value it holds now rather than recomputed from the enable time.
+//*****************************************************************************
+static uint32_t
+syncValue(uint32_t base)
+{
+    gpTimer_t *timer = getTimer(base);
+    uint64_t now = simCycles();
+    uint32_t elapsed = (uint32_t)(now - timer->lastSync);
+    volatile uint32_t *value = simRegister(base + TIMER_O_TAV);
+    timer->lastSync = now;
+    if (!timer->enabled) {
+        return *value;
+    }
+    if (timer->config & TIMER_CFG_UP) {
+        *value += elapsed;
+        if (timer->load != 0) {
+            *value %= timer->load;
+        }
+    } else {
+        uint64_t period = (uint64_t)timer->load + 1;
+        *value = (uint32_t)((*value + period - (elapsed % period)) % period);
+    }
+    return *value;
+}
+
+void
+TimerConfigure(uint32_t ui32Base, uint32_t ui32Config)
+{
+    gpTimer_t *timer = getTimer(ui32Base);
+    simConsume(SIM_CALL_CYCLES);
+    timer->config = ui32Config;
+    timer->enabled = false;
+    timer->load = (ui32Config & TIMER_CFG_UP) ? 0 : UINT32_MAX;
+    timer->load64 = UINT64_MAX;
+    timer->count64 = 0;
+    timer->adcTrigger = false;
+    *simRegister(ui32Base + TIMER_O_TAV) = (ui32Config & TIMER_CFG_UP) ? 0 : UINT32_MAX;
+    scheduleTimeout(ui32Base);
+}
+
+void
+TimerEnable(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    gpTimer_t *timer = getTimer(ui32Base);
+    simConsume(SIM_CALL_CYCLES);
+    timer->enabled = true;
+    timer->lastSync = simCycles();
+    scheduleTimeout(ui32Base);
+}
+
+void
+TimerDisable(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    simConsume(SIM_CALL_CYCLES);
+    syncValue(ui32Base);
+    getTimer(ui32Base)->enabled = false;
+    scheduleTimeout(ui32Base);
+}
+
+void
+TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value)
+{
+    gpTimer_t *timer = getTimer(ui32Base);
+    simConsume(SIM_CALL_CYCLES);
+    timer->load = ui32Value;
+    if (!(timer->config & TIMER_CFG_UP)) {
+        *simRegister(ui32Base + TIMER_O_TAV) = ui32Value;
+    }
+    timer->lastSync = simCycles();
+    scheduleTimeout(ui32Base);
+}
+
+uint32_t
+TimerLoadGet(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return getTimer(ui32Base)->load;
+}
+
+uint32_t
+TimerValueGet(uint32_t ui32Base, uint32_t ui32Timer)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return syncValue(ui32Base);
+}
+
+void
+TimerControlTrigger(uint32_t ui32Base, uint32_t ui32Timer, bool bEnable)
+{
+    simConsume(SIM_CALL_CYCLES);
+    syncValue(ui32Base);
+    getTimer(ui32Base)->adcTrigger = bEnable;
+    scheduleTimeout(ui32Base);
+}
+
+void
+TimerIntRegister(uint32_t ui32Base, uint32_t ui32Timer, void (*pfnHandler)(void))
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntRegister(intNums[timerNumber(ui32Base)], pfnHandler);
+    simIntEnable(intNums[timerNumber(ui32Base)], true);
+}
+
+void
+TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    simConsume(SIM_CALL_CYCLES);
+    syncValue(ui32Base);
+    getTimer(ui32Base)->intMask |= ui32IntFlags;
+    scheduleTimeout(ui32Base);
+}
+
+void
+TimerIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    simConsume(SIM_CALL_CYCLES);
+    syncValue(ui32Base);
+    getTimer(ui32Base)->intMask &= ~ui32IntFlags;
+    scheduleTimeout(ui32Base);
+}
+
+uint32_t
+TimerIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    gpTimer_t *timer = getTimer(ui32Base);
+    simConsume(SIM_CALL_CYCLES);
+    return bMasked ? timer->intStatus & timer->intMask : timer->intStatus;
+}
+
+void
+TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getTimer(ui32Base)->intStatus &= ~ui32IntFlags;
+}
+
+void
+TimerLoadSet64(uint32_t ui32Base, uint64_t ui64Value)
+{
+    gpTimer_t *timer = getTimer(ui32Base);
+    simConsume(SIM_CALL_CYCLES);
+    timer->load64 = ui64Value;
+    timer->count64 = (timer->config & TIMER_CFG_UP) ? 0 : ui64Value;
+    timer->lastSync = simCycles();
+}
+
+uint64_t
+TimerValueGet64(uint32_t ui32Base)
+{
+    gpTimer_t *timer = getTimer(ui32Base);
+    uint64_t now = simCycles();
+    uint64_t elapsed = now - timer->lastSync;
+    simConsume(SIM_CALL_CYCLES);
+    timer->lastSync = now;
+    if (!timer->enabled) {
+        return timer->count64;
+    }
+    if (timer->config & TIMER_CFG_UP) {
+        timer->count64 = timer->load64 == UINT64_MAX ? timer->count64 + elapsed
+                         : (timer->count64 + elapsed) % (timer->load64 + 1);
+    } else {
+        uint64_t period = timer->load64 == UINT64_MAX ? UINT64_MAX : timer->load64 + 1;
+        elapsed %= period;
+        timer->count64 = timer->count64 >= elapsed ? timer->count64 - elapsed
+                         : timer->count64 + period - elapsed;
+    }
+    return timer->count64;
+}
@@ -0,0 +1,44 @@
+/*
+ * timer.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare general purpose timer driver. Full
+ *      width timers count from the virtual clock; the OLED driver uses Timer 1 counting
+ *      up for its millisecond delays. A timer counting down raises its timeout interrupt
+ *      each time it reloads, from a timed simulator event. Wide timers also count the full
+ *      64 bits, read with TimerValueGet64() only.
+ */
+
+#ifndef __DRIVERLIB_TIMER_H__
+#define __DRIVERLIB_TIMER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TIMER_CFG_ONE_SHOT      0x00000021
+#define TIMER_CFG_ONE_SHOT_UP   0x00000031
+#define TIMER_CFG_PERIODIC      0x00000022
+#define TIMER_CFG_PERIODIC_UP   0x00000032
+
+#define TIMER_A                 0x000000FF
+#define TIMER_B                 0x0000FF00
+#define TIMER_BOTH              0x0000FFFF
+
+#define TIMER_TIMA_TIMEOUT      0x00000001
+
+void TimerConfigure(uint32_t ui32Base, uint32_t ui32Config);
+void TimerEnable(uint32_t ui32Base, uint32_t ui32Timer);
+void TimerDisable(uint32_t ui32Base, uint32_t ui32Timer);
+void TimerLoadSet(uint32_t ui32Base, uint32_t ui32Timer, uint32_t ui32Value);
+uint32_t TimerLoadGet(uint32_t ui32Base, uint32_t ui32Timer);
+uint32_t TimerValueGet(uint32_t ui32Base, uint32_t ui32Timer);
+void TimerLoadSet64(uint32_t ui32Base, uint64_t ui64Value);
+uint64_t TimerValueGet64(uint32_t ui32Base);
+void TimerControlTrigger(uint32_t ui32Base, uint32_t ui32Timer, bool bEnable);
+void TimerIntRegister(uint32_t ui32Base, uint32_t ui32Timer, void (*pfnHandler)(void));
+void TimerIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+void TimerIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t TimerIntStatus(uint32_t ui32Base, bool bMasked);
+void TimerIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+
+#endif /* __DRIVERLIB_TIMER_H__ */
@@ -0,0 +1,220 @@
+/*
+ * uart.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare UART driver. Models UART0 with its
+ *      transmit FIFO draining at the configured baud rate, so blocking transmits cost
+ *      the same virtual time as on the board. Characters the rig sends arrive at once
+ *      and raise the receive interrupt while it is enabled.
+ */
+
+#include <stdio.h>
+#include "inc/hw_ints.h"
+#include "driverlib/uart.h"
+#include "sim/simCore.h"
+#include "sim/simHardware.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define UART_FIFO_DEPTH 16
+#define UART_FRAME_BITS 10          // Start bit, eight data bits and a stop bit
+#define UART_RX_BUFFER 256
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static uint32_t charCycles = 1;     // Cycles to shift one frame out
+static uint32_t fifoDepth = 1;      // Holding register only until the FIFO is enabled
+static uint64_t txDoneAt;           // Cycle count the last queued frame finishes at
+static FILE *txOutput;              // Where transmitted characters are copied to
+static char rxBuffer[UART_RX_BUFFER];
+static uint32_t rxHead;
+static uint32_t rxTail;
+static uint32_t intMask;            // Enabled interrupt sources
+
+//*****************************************************************************
+// @return uint32_t Number of frames still waiting to be shifted out
+//*****************************************************************************
+static uint32_t
+framesQueued(void)
+{
+    uint64_t now = simCycles();
+    if (txDoneAt <= now) {
+        return 0;
+    }
+    return (uint32_t)((txDoneAt - now + charCycles - 1) / charCycles);
+}
+
+void
+UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t ui32Baud,
+                    uint32_t ui32Config)
+{
+    simConsume(SIM_CALL_CYCLES);
+    charCycles = (uint32_t)((uint64_t)ui32UARTClk * UART_FRAME_BITS / ui32Baud);
+}
+
+void
+UARTEnable(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+void
+UARTDisable(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+}
+
+void
+UARTFIFOEnable(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+    fifoDepth = UART_FIFO_DEPTH;
+}
+
+void
+UARTFIFODisable(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+    fifoDepth = 1;
+}
+
+bool
+UARTSpaceAvail(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+    // One frame is in the shift register, the rest sit in the FIFO
+    return framesQueued() <= fifoDepth;
+}
+
+bool
+UARTBusy(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return framesQueued() > 0;
+}
+
+//*****************************************************************************
+// Shifts a frame out after those already queued
+//*****************************************************************************
+static void
+queueFrame(unsigned char ucData)
+{
+    uint64_t now = simCycles();
+    txDoneAt = (txDoneAt > now ? txDoneAt : now) + charCycles;
+    if (txOutput != NULL) {
+        fputc(ucData, txOutput);
+    }
+}
+
+void
+UARTCharPut(uint32_t ui32Base, unsigned char ucData)
+{
+    simConsume(SIM_CALL_CYCLES);
+    // Block until the FIFO has room, as the driver spins on the TXFF flag
+    if (framesQueued() > fifoDepth) {
+        simConsumeUntil(txDoneAt - (uint64_t)fifoDepth * charCycles);
+    }
+    queueFrame(ucData);
+}
+
+bool
+UARTCharPutNonBlocking(uint32_t ui32Base, unsigned char ucData)
+{
+    simConsume(SIM_CALL_CYCLES);
+    if (framesQueued() > fifoDepth) {
+        return false;
+    }
+    queueFrame(ucData);
+    return true;
+}
+
+bool
+UARTCharsAvail(uint32_t ui32Base)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return rxHead != rxTail;
+}
+
+int32_t
+UARTCharGetNonBlocking(uint32_t ui32Base)
+{
+    char data;
+    simConsume(SIM_CALL_CYCLES);
+    if (rxHead == rxTail) {
+        return -1;
+    }
+    data = rxBuffer[rxTail];
+    rxTail = (rxTail + 1) % UART_RX_BUFFER;
+    return (unsigned char)data;
+}
+
+//*****************************************************************************
+// Raises the receive interrupt if data is waiting and it is enabled
+//*****************************************************************************
+static void
+raiseReceive(void)
+{
+    if (rxHead != rxTail && (intMask & (UART_INT_RX | UART_INT_RT)) != 0) {
+        simIntPend(INT_UART0);
+    }
+}
+
+void
+UARTIntRegister(uint32_t ui32Base, void (*pfnHandler)(void))
+{
+    simConsume(SIM_CALL_CYCLES);
+    simIntRegister(INT_UART0, pfnHandler);
+    simIntEnable(INT_UART0, true);
+}
+
+void
+UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    simConsume(SIM_CALL_CYCLES);
+    intMask |= ui32IntFlags;
+    raiseReceive();
+}
+
+void
+UARTIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    simConsume(SIM_CALL_CYCLES);
+    intMask &= ~ui32IntFlags;
+}
+
+uint32_t
+UARTIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    uint32_t status = rxHead != rxTail ? UART_INT_RX | UART_INT_RT : 0;
+    simConsume(SIM_CALL_CYCLES);
+    return bMasked ? status & intMask : status;
+}
+
+void
+UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    // The sources follow the receive buffer, so there is no latch to clear
+    simConsume(SIM_CALL_CYCLES);
+}
+
+void
+simUartSetOutput(FILE *output)
+{
+    txOutput = output;
+}
+
+void
+simUartReceive(const char *data)
+{
+    while (*data) {
+        uint32_t next = (rxHead + 1) % UART_RX_BUFFER;
+        if (next == rxTail) {
+            break;
+        }
+        rxBuffer[rxHead] = *data++;
+        rxHead = next;
+    }
+    raiseReceive();
+}
@@ -0,0 +1,50 @@
+/*
+ * uart.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare UART driver. Models UART0 with its
+ *      transmit FIFO draining at the configured baud rate, so blocking transmits cost
+ *      the same virtual time as on the board, and a receive interrupt for characters
+ *      the rig sends.
+ */
+
+#ifndef __DRIVERLIB_UART_H__
+#define __DRIVERLIB_UART_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//*****************************************************************************
+// Line configuration
+//*****************************************************************************
+#define UART_CONFIG_WLEN_8      0x00000060
+#define UART_CONFIG_WLEN_7      0x00000040
+#define UART_CONFIG_STOP_ONE    0x00000000
+#define UART_CONFIG_STOP_TWO    0x00000008
+#define UART_CONFIG_PAR_NONE    0x00000000
+
+//*****************************************************************************
+// Interrupt sources
+//*****************************************************************************
+#define UART_INT_RX             0x010       // Receive FIFO past its trigger level
+#define UART_INT_RT             0x040       // Receive timeout, data waiting
+
+void UARTConfigSetExpClk(uint32_t ui32Base, uint32_t ui32UARTClk, uint32_t ui32Baud,
+                         uint32_t ui32Config);
+void UARTEnable(uint32_t ui32Base);
+void UARTDisable(uint32_t ui32Base);
+void UARTFIFOEnable(uint32_t ui32Base);
+void UARTFIFODisable(uint32_t ui32Base);
+bool UARTSpaceAvail(uint32_t ui32Base);
+bool UARTBusy(uint32_t ui32Base);
+void UARTCharPut(uint32_t ui32Base, unsigned char ucData);
+bool UARTCharPutNonBlocking(uint32_t ui32Base, unsigned char ucData);
+bool UARTCharsAvail(uint32_t ui32Base);
+int32_t UARTCharGetNonBlocking(uint32_t ui32Base);
+void UARTIntRegister(uint32_t ui32Base, void (*pfnHandler)(void));
+void UARTIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags);
+void UARTIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags);
+uint32_t UARTIntStatus(uint32_t ui32Base, bool bMasked);
+void UARTIntClear(uint32_t ui32Base, uint32_t ui32IntFlags);
+
+#endif /* __DRIVERLIB_UART_H__ */
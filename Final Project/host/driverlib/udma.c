@@ -0,0 +1,199 @@
+/*
+ * udma.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare uDMA driver. Each channel has a
+ *      primary and alternate control structure. A peripheral request moves one item
+ *      into the active structure's destination; when the structure's count runs out
+ *      it stops, and a ping-pong transfer carries on in the other structure if the
+ *      firmware has set it up again, or the channel disables itself if not.
+ */
+
+#include <stddef.h>
+#include "driverlib/udma.h"
+#include "sim/simCore.h"
+#include "sim/simPeripherals.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define NUM_CHANNELS 32
+#define CHANNEL_MASK 0x1F
+#define DST_INC_SHIFT 30
+#define DST_SIZE_SHIFT 28
+#define FIELD_MASK 0x3
+#define INC_NONE 0x3
+
+//*****************************************************************************
+// Structs
+//*****************************************************************************
+typedef struct {
+    uint32_t control;
+    uint32_t mode;
+    uint8_t *dst;           // Where the next item goes
+    uint32_t remaining;     // Items left in the transfer
+} udmaStruct_t;
+
+typedef struct {
+    udmaStruct_t structs[2];    // Primary, then alternate
+    uint32_t attributes;
+    bool enabled;
+    bool alternate;             // The alternate structure is active
+} udmaChannel_t;
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static udmaChannel_t channels[NUM_CHANNELS];
+static bool controllerEnabled;
+
+//*****************************************************************************
+// @return udmaStruct_t* The control structure for a channel number ORed with
+// UDMA_PRI_SELECT or UDMA_ALT_SELECT
+//*****************************************************************************
+static udmaStruct_t *
+getStruct(uint32_t structIndex)
+{
+    return &channels[structIndex & CHANNEL_MASK].structs[(structIndex & UDMA_ALT_SELECT) ? 1 : 0];
+}
+
+simUdmaResult_t
+simUdmaRequest(uint32_t channel, uint32_t value)
+{
+    udmaChannel_t *dma = &channels[channel & CHANNEL_MASK];
+    udmaStruct_t *active = &dma->structs[dma->alternate ? 1 : 0];
+    uint32_t size;
+    uint32_t increment;
+
+    if (!controllerEnabled || !dma->enabled || (dma->attributes & UDMA_ATTR_REQMASK)
+            || active->mode == UDMA_MODE_STOP || active->remaining == 0) {
+        return SIM_UDMA_REFUSED;
+    }
+    size = 1u << ((active->control >> DST_SIZE_SHIFT) & FIELD_MASK);
+    increment = (active->control >> DST_INC_SHIFT) & FIELD_MASK;
+    if (size == 1) {
+        *active->dst = (uint8_t)value;
+    } else if (size == 2) {
+        *(uint16_t *)active->dst = (uint16_t)value;
+    } else {
+        *(uint32_t *)active->dst = value;
+    }
+    if (increment != INC_NONE) {
+        active->dst += 1u << increment;
+    }
+    active->remaining--;
+    if (active->remaining > 0) {
+        return SIM_UDMA_MOVED;
+    }
+
+    // The structure is spent. Ping-pong carries on in the other one if it is set up.
+    if (active->mode == UDMA_MODE_PINGPONG) {
+        dma->alternate = !dma->alternate;
+        if (dma->structs[dma->alternate ? 1 : 0].mode == UDMA_MODE_STOP) {
+            dma->enabled = false;
+        }
+    } else {
+        dma->enabled = false;
+    }
+    active->mode = UDMA_MODE_STOP;
+    return SIM_UDMA_DONE;
+}
+
+void
+uDMAEnable(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    controllerEnabled = true;
+}
+
+void
+uDMADisable(void)
+{
+    simConsume(SIM_CALL_CYCLES);
+    controllerEnabled = false;
+}
+
+void
+uDMAControlBaseSet(void *pControlTable)
+{
+    simConsume(SIM_CALL_CYCLES);
+    // The control structures are kept in this model rather than the firmware's table
+    (void)pControlTable;
+}
+
+void
+uDMAChannelAttributeEnable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    udmaChannel_t *dma = &channels[ui32ChannelNum & CHANNEL_MASK];
+    simConsume(SIM_CALL_CYCLES);
+    dma->attributes |= ui32Attr;
+    if (ui32Attr & UDMA_ATTR_ALTSELECT) {
+        dma->alternate = true;
+    }
+}
+
+void
+uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    udmaChannel_t *dma = &channels[ui32ChannelNum & CHANNEL_MASK];
+    simConsume(SIM_CALL_CYCLES);
+    dma->attributes &= ~ui32Attr;
+    if (ui32Attr & UDMA_ATTR_ALTSELECT) {
+        dma->alternate = false;
+    }
+}
+
+void
+uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control)
+{
+    simConsume(SIM_CALL_CYCLES);
+    getStruct(ui32ChannelStructIndex)->control = ui32Control;
+}
+
+void
+uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                       void *pvSrcAddr, void *pvDstAddr, uint32_t ui32TransferSize)
+{
+    udmaStruct_t *dmaStruct = getStruct(ui32ChannelStructIndex);
+    simConsume(SIM_CALL_CYCLES);
+    // Sources are peripheral FIFOs, which the requesting peripheral supplies
+    (void)pvSrcAddr;
+    dmaStruct->mode = ui32Mode;
+    dmaStruct->dst = pvDstAddr;
+    dmaStruct->remaining = ui32TransferSize;
+}
+
+void
+uDMAChannelEnable(uint32_t ui32ChannelNum)
+{
+    simConsume(SIM_CALL_CYCLES);
+    channels[ui32ChannelNum & CHANNEL_MASK].enabled = true;
+}
+
+void
+uDMAChannelDisable(uint32_t ui32ChannelNum)
+{
+    simConsume(SIM_CALL_CYCLES);
+    channels[ui32ChannelNum & CHANNEL_MASK].enabled = false;
+}
+
+bool
+uDMAChannelIsEnabled(uint32_t ui32ChannelNum)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return channels[ui32ChannelNum & CHANNEL_MASK].enabled;
+}
+
+uint32_t
+uDMAChannelModeGet(uint32_t ui32ChannelStructIndex)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return getStruct(ui32ChannelStructIndex)->mode;
+}
+
+uint32_t
+uDMAChannelSizeGet(uint32_t ui32ChannelStructIndex)
+{
+    simConsume(SIM_CALL_CYCLES);
+    return getStruct(ui32ChannelStructIndex)->remaining;
+}
@@ -0,0 +1,205 @@
+/*
+ * heliConvert.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host tool that checks the integer altitude conversion in altitude.c
+ *      against the floating point conversion it replaced. Every pair of 12 bit readings
+ *      is converted both ways and any difference is listed, then both conversions are
+ *      timed. Each conversion's reading depends on the last one's result, so the host
+ *      cannot overlap them or hoist them out of the loop, and the time of the same loop
+ *      with an empty conversion is taken off. The host has a double precision FPU, which
+ *      the TM4C123's single precision FPU lacks, so the double conversion costs far more
+ *      on the board than the ratio here shows. Exits with failure if any result differs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "altitude.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define DEFAULT_ROUNDS 20           // Passes over every initial reading when timing
+#define TIMING_REPEATS 5            // Timings of each conversion, the quickest is kept
+#define MAX_LISTED 10               // Differences printed before they are only counted
+#define NS_PER_SECOND 1000000000.0
+#define MAX_VOLTAGE ((double)MAX_VOLTAGE_MV / MV_PER_VOLT)
+
+//*****************************************************************************
+// @param adcOutput The averaged output from the adc module
+//
+// @param initialAdc The first adc reading
+//
+// @return int32_t The percentage altitude, as altitude.c converted it in floating point
+//*****************************************************************************
+static int32_t
+doubleCalculator(int32_t adcOutput, double initialAdc)
+{
+    double scaledInitial = initialAdc * PERCENTAGE_CONVERSION;
+    double scaledCurrent = adcOutput * PERCENTAGE_CONVERSION;
+    double scaledInitialVoltage = (scaledInitial * MAX_VOLTAGE)/ADC_STEPS;
+    double scaledVoltageOutput = (scaledCurrent * MAX_VOLTAGE)/ADC_STEPS;
+    return -(scaledVoltageOutput-scaledInitialVoltage);
+}
+
+//*****************************************************************************
+// @return int32_t The drop in the reading, to time the loop and call without a conversion
+//*****************************************************************************
+static int32_t
+emptyCalculator(int32_t adcOutput, int32_t initialAdc)
+{
+    return initialAdc - adcOutput;
+}
+
+// Called through pointers, so no conversion is folded into the timing loop
+static int32_t (*volatile doubleConversion)(int32_t, double) = doubleCalculator;
+static int32_t (*volatile integerConversion)(int32_t, int32_t) = percentageCalculator;
+static int32_t (*volatile emptyConversion)(int32_t, int32_t) = emptyCalculator;
+// Takes the last reading of each timing, so the conversions cannot be left out
+static volatile int32_t sink;
+
+typedef enum {
+    CONVERT_DOUBLE,
+    CONVERT_INTEGER,
+    CONVERT_EMPTY
+} conversion_t;
+
+//*****************************************************************************
+// @return double Seconds on the host's monotonic clock
+//*****************************************************************************
+static double
+nowSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / NS_PER_SECOND;
+}
+
+//*****************************************************************************
+// @return uint32_t The number of pairs of readings the two conversions disagree on
+//*****************************************************************************
+static uint32_t
+checkEquivalence(void)
+{
+    uint32_t differences = 0;
+    int32_t initialAdc;
+    int32_t adcOutput;
+    int32_t expected;
+    int32_t actual;
+
+    for (initialAdc = 0; initialAdc < ADC_STEPS; initialAdc++) {
+        for (adcOutput = 0; adcOutput < ADC_STEPS; adcOutput++) {
+            expected = doubleCalculator(adcOutput, initialAdc);
+            actual = percentageCalculator(adcOutput, initialAdc);
+            if (actual != expected) {
+                if (differences < MAX_LISTED) {
+                    printf("adc %4d initial %4d: double %4d integer %4d\n",
+                           adcOutput, initialAdc, expected, actual);
+                }
+                differences++;
+            }
+        }
+    }
+    return differences;
+}
+
+//*****************************************************************************
+// @param rounds Passes over every initial reading
+//
+// @param conversion The conversion to time
+//
+// @return double Nanoseconds per conversion, loop included, the quickest of
+// TIMING_REPEATS timings
+//*****************************************************************************
+static double
+timeConversion(uint32_t rounds, conversion_t conversion)
+{
+    double bestNs = 0.0;
+    double ns;
+    double startSeconds;
+    uint32_t repeat;
+    uint32_t round;
+    uint32_t count;
+    int32_t initialAdc;
+    int32_t adcOutput = 0;
+    int32_t result;
+
+    for (repeat = 0; repeat < TIMING_REPEATS; repeat++) {
+        startSeconds = nowSeconds();
+        for (round = 0; round < rounds; round++) {
+            for (initialAdc = 0; initialAdc < ADC_STEPS; initialAdc++) {
+                for (count = 0; count < ADC_STEPS / 16; count++) {
+                    if (conversion == CONVERT_DOUBLE) {
+                        result = doubleConversion(adcOutput, initialAdc);
+                    } else if (conversion == CONVERT_INTEGER) {
+                        result = integerConversion(adcOutput, initialAdc);
+                    } else {
+                        result = emptyConversion(adcOutput, initialAdc);
+                    }
+                    // The next reading waits on this result, so each conversion is timed
+                    // from start to finish
+                    adcOutput = (adcOutput + result + 1) & (ADC_STEPS - 1);
+                }
+            }
+        }
+        ns = (nowSeconds() - startSeconds) * NS_PER_SECOND
+             / ((double)rounds * ADC_STEPS * (ADC_STEPS / 16));
+        if (repeat == 0 || ns < bestNs) {
+            bestNs = ns;
+        }
+    }
+    sink = adcOutput;
+    return bestNs;
+}
+
+static void
+usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [-r rounds]\n"
+            "  -r  timing passes over the readings (default %d)\n",
+            program, DEFAULT_ROUNDS);
+}
+
+int
+main(int argc, char **argv)
+{
+    uint32_t rounds = DEFAULT_ROUNDS;
+    uint32_t differences;
+    double doubleNs;
+    double integerNs;
+    double emptyNs;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:")) != -1) {
+        switch (opt) {
+        case 'r':
+            rounds = strtoul(optarg, NULL, 10);
+            if (rounds == 0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    differences = checkEquivalence();
+    printf("equivalence: %u of %u reading pairs differ\n", differences,
+           (uint32_t)ADC_STEPS * ADC_STEPS);
+
+    // The loop and call cost the same for each, so take them off
+    emptyNs = timeConversion(rounds, CONVERT_EMPTY);
+    doubleNs = timeConversion(rounds, CONVERT_DOUBLE) - emptyNs;
+    integerNs = timeConversion(rounds, CONVERT_INTEGER) - emptyNs;
+    printf("loop and call %6.2f ns, taken off each conversion below\n", emptyNs);
+    printf("double  %6.2f ns per conversion\n", doubleNs);
+    printf("integer %6.2f ns per conversion\n", integerNs);
+    if (integerNs > 0.0) {
+        printf("double takes %.1f times as long on the host\n", doubleNs / integerNs);
+    }
+    return differences == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
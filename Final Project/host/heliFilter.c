@@ -0,0 +1,236 @@
+/*
+ * heliFilter.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host tool that compares the altitude filters in filters.c. Each
+ *      filter runs with the coefficients altitude.c starts it with, at SAMPLE_RATE_HZ,
+ *      through a sine, a step and noise, and the report gives the phase lag of the sine,
+ *      the time the step takes to get half way, how much noise is left, and the host time
+ *      each sample takes. The lag and noise show what each filter trades against the
+ *      others, and the time what it costs the ADC handler.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "altitude.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define DEFAULT_SINE_HZ 1.0
+#define DEFAULT_NOISE_LSB 20
+#define MID_SCALE 2048              // Centre of the test signals, in ADC steps
+#define SINE_AMPLITUDE 1000
+#define STEP_SIZE 1000
+#define SETTLE_SECONDS 5.0          // Run before measuring, to forget the start
+#define MEASURE_SECONDS 20.0
+#define TIMED_SAMPLES 2000000
+#define NS_PER_SECOND 1000000000.0
+#define MS_PER_SECOND 1000.0
+#define DEGREES_PER_CYCLE 360.0
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static double sineHz = DEFAULT_SINE_HZ;
+static uint32_t noiseLsb = DEFAULT_NOISE_LSB;
+static uint32_t noiseState = 1;
+
+//*****************************************************************************
+// @return int32_t Uniform noise from -noiseLsb to noiseLsb, the same every run
+//*****************************************************************************
+static int32_t
+nextNoise(void)
+{
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    return (int32_t)(noiseState % (2 * noiseLsb + 1)) - (int32_t)noiseLsb;
+}
+
+//*****************************************************************************
+// @param config Filter to measure
+//
+// @param gain Set to the output amplitude over the input's
+//
+// @return double The phase lag of the output behind a sine at sineHz, in degrees
+//*****************************************************************************
+static double
+measureSine(const filterConfig_t *config, double *gain)
+{
+    filter_t filter;
+    double inI = 0.0, inQ = 0.0, outI = 0.0, outQ = 0.0;
+    double phase;
+    double output;
+    int32_t sample;
+    uint32_t settle = SETTLE_SECONDS * SAMPLE_RATE_HZ;
+    uint32_t total = settle + MEASURE_SECONDS * SAMPLE_RATE_HZ;
+    uint32_t n;
+
+    initFilter(&filter, config, MID_SCALE);
+    for (n = 0; n < total; n++) {
+        phase = 2.0 * M_PI * sineHz * n / SAMPLE_RATE_HZ;
+        sample = MID_SCALE + lround(SINE_AMPLITUDE * sin(phase));
+        output = runFilter(&filter, sample) - MID_SCALE;
+        if (n >= settle) {
+            inI += (sample - MID_SCALE) * cos(phase);
+            inQ += (sample - MID_SCALE) * sin(phase);
+            outI += output * cos(phase);
+            outQ += output * sin(phase);
+        }
+    }
+    *gain = hypot(outI, outQ) / hypot(inI, inQ);
+    phase = (atan2(inI, inQ) - atan2(outI, outQ)) * DEGREES_PER_CYCLE / (2.0 * M_PI);
+    // Lag is positive, and a filter this slow would not be used
+    while (phase < 0.0) {
+        phase += DEGREES_PER_CYCLE;
+    }
+    return phase;
+}
+
+//*****************************************************************************
+// @param config Filter to measure
+//
+// @return double Milliseconds a step takes to get half way through the filter
+//*****************************************************************************
+static double
+measureStep(const filterConfig_t *config)
+{
+    filter_t filter;
+    uint32_t limit = MEASURE_SECONDS * SAMPLE_RATE_HZ;
+    uint32_t n;
+
+    initFilter(&filter, config, MID_SCALE);
+    // Settle first, as the CIC filter holds its output until its combs are full
+    for (n = 0; n < SETTLE_SECONDS * SAMPLE_RATE_HZ; n++) {
+        runFilter(&filter, MID_SCALE);
+    }
+    // The step is at sample 0, so a filter with no delay is half way at once
+    for (n = 0; n < limit; n++) {
+        if (runFilter(&filter, MID_SCALE + STEP_SIZE) >= MID_SCALE + STEP_SIZE / 2) {
+            break;
+        }
+    }
+    return n * MS_PER_SECOND / SAMPLE_RATE_HZ;
+}
+
+//*****************************************************************************
+// @param config Filter to measure
+//
+// @return double The RMS noise out over the RMS noise in
+//*****************************************************************************
+static double
+measureNoise(const filterConfig_t *config)
+{
+    filter_t filter;
+    double inSquares = 0.0, outSquares = 0.0;
+    int32_t noise;
+    int32_t output;
+    uint32_t settle = SETTLE_SECONDS * SAMPLE_RATE_HZ;
+    uint32_t total = settle + MEASURE_SECONDS * SAMPLE_RATE_HZ;
+    uint32_t n;
+
+    if (noiseLsb == 0) {
+        return 0.0;
+    }
+    noiseState = 1;
+    initFilter(&filter, config, MID_SCALE);
+    for (n = 0; n < total; n++) {
+        noise = nextNoise();
+        output = runFilter(&filter, MID_SCALE + noise) - MID_SCALE;
+        if (n >= settle) {
+            inSquares += (double)noise * noise;
+            outSquares += (double)output * output;
+        }
+    }
+    return sqrt(outSquares / inSquares);
+}
+
+//*****************************************************************************
+// @param config Filter to measure
+//
+// @return double Host nanoseconds runFilter() takes for each sample
+//*****************************************************************************
+static double
+measureCost(const filterConfig_t *config)
+{
+    filter_t filter;
+    struct timespec start, end;
+    volatile int32_t sink = 0;
+    uint32_t n;
+
+    noiseState = 1;
+    initFilter(&filter, config, MID_SCALE);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (n = 0; n < TIMED_SAMPLES; n++) {
+        sink += runFilter(&filter, MID_SCALE + (int32_t)(n & 0xff));
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    (void)sink;
+    return ((end.tv_sec - start.tv_sec) * NS_PER_SECOND + (end.tv_nsec - start.tv_nsec))
+           / TIMED_SAMPLES;
+}
+
+static void
+usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [-f Hz] [-n lsb]\n"
+            "  -f  frequency of the sine the lag is measured on (default %.1f Hz)\n"
+            "  -n  noise added to each sample, +/- ADC steps (default %d)\n",
+            program, DEFAULT_SINE_HZ, DEFAULT_NOISE_LSB);
+}
+
+int
+main(int argc, char **argv)
+{
+    filterConfig_t config;
+    filterType_t type;
+    double lagDegrees;
+    double gain;
+    uint32_t index;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:n:")) != -1) {
+        switch (opt) {
+        case 'f':
+            sineHz = atof(optarg);
+            if (sineHz <= 0.0 || sineHz >= SAMPLE_RATE_HZ / 2.0) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'n':
+            noiseLsb = strtoul(optarg, NULL, 10);
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("filters at %d Hz, lag on a %.2f Hz sine, noise +/- %u steps\n", SAMPLE_RATE_HZ,
+           sineHz, noiseLsb);
+    printf("%-28s %8s %8s %7s %8s %8s %7s %8s\n", "filter", "delay ms", "lag deg", "lag ms",
+           "gain", "step ms", "noise", "ns/samp");
+    for (type = 0; type < NUM_FILTER_TYPES; type++) {
+        char name[32];
+        size_t used;
+
+        getAltitudeFilterPreset(type, &config);
+        used = snprintf(name, sizeof(name), "%s", filterName(type));
+        for (index = 0; index < filterCoefficientCount(type) && used < sizeof(name); index++) {
+            used += snprintf(name + used, sizeof(name) - used, " %d",
+                             config.coefficients[index]);
+        }
+        lagDegrees = measureSine(&config, &gain);
+        printf("%-28s %8.1f %8.1f %7.1f %8.3f %8.1f %7.3f %8.2f\n", name,
+               getFilterDelay(&config) * MS_PER_SECOND / SAMPLE_RATE_HZ
+               / (1 << FILTER_DELAY_Q_BITS),
+               lagDegrees, lagDegrees / DEGREES_PER_CYCLE / sineHz * MS_PER_SECOND, gain,
+               measureStep(&config), measureNoise(&config), measureCost(&config));
+    }
+    return EXIT_SUCCESS;
+}
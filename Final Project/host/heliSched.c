@@ -0,0 +1,249 @@
+/*
+ * heliSched.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host tool that checks the task set is schedulable. Flies the unmodified
+ *      firmware through a takeoff and landing against the rig model, takes the longest
+ *      release, slice and interrupt time it measured for every task, and runs the same
+ *      response time analysis the firmware runs on its budgets at boot. Rates and run
+ *      times can be changed on the command line to see whether a change would still meet
+ *      every deadline before it is flown. Exits with failure if any task may miss one.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "sim/simCore.h"
+#include "sim/simHardware.h"
+#include "sim/simPlant.h"
+#include "profiler.h"
+#include "schedulability.h"
+#include "switches.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define DEFAULT_RUN_SECONDS 40.0
+#define TAKEOFF_SECONDS 1.0
+#define DEFAULT_LAND_SECONDS 25.0
+#define PERCENT 100
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+#define TASK_NAME(index, function, rateHz, phase, priority, policy, wcetUs, trigger, tier) #index,
+static const char *taskNames[NUMTASKS] = {
+    TASK_TABLE(TASK_NAME)
+};
+
+static double landSeconds = DEFAULT_LAND_SECONDS;
+static uint32_t rateOverride[NUMTASKS];     // Rate in Hz to analyse instead, 0 to keep
+static uint32_t runPercent = PERCENT;       // Scale applied to the measured run times
+
+//*****************************************************************************
+// The firmware main() from finalMain.c, renamed by the host build
+//*****************************************************************************
+int firmwareMain(void);
+
+static void
+takeoffHandler(void)
+{
+    simGpioDrive(SW_PORT, SW1_GPIO_PIN, SW1_GPIO_PIN);
+}
+
+static void
+landHandler(void)
+{
+    simGpioDrive(SW_PORT, SW1_GPIO_PIN, 0);
+}
+
+//*****************************************************************************
+// @param cycles Time in system clock cycles
+//
+// @return double The time in microseconds
+//*****************************************************************************
+static double
+toUs(uint64_t cycles)
+{
+    return (double)cycles * US_PER_SECOND / simClockHz();
+}
+
+//*****************************************************************************
+// @param arg Option of the form TASK=Hz, the task by name or index
+//
+// @return bool False if the option is not understood
+//*****************************************************************************
+static bool
+parseRate(const char *arg)
+{
+    const char *equals = strchr(arg, '=');
+    size_t index;
+    char *end;
+
+    if (equals == NULL || atoi(equals + 1) <= 0) {
+        return false;
+    }
+    for (index = 0; index < NUMTASKS; index++) {
+        if (strlen(taskNames[index]) == (size_t)(equals - arg)
+                && strncmp(taskNames[index], arg, equals - arg) == 0) {
+            break;
+        }
+    }
+    if (index == NUMTASKS) {
+        index = strtoul(arg, &end, 0);
+        if (end != equals || index >= NUMTASKS) {
+            return false;
+        }
+    }
+    rateOverride[index] = atoi(equals + 1);
+    return true;
+}
+
+//*****************************************************************************
+// @param title Heading for the report
+//
+// @param demand Demand of each task
+//
+// @param isrCycles Most interrupt time in one SysTick period
+//
+// @return bool True if every task meets its deadline
+//*****************************************************************************
+static bool
+report(const char *title, const taskDemand_t demand[NUMTASKS], uint32_t isrCycles)
+{
+    taskResponse_t response[NUMTASKS];
+    bool schedulable = analyseSchedule(demand, isrCycles, response);
+    double bound = NUMTASKS * (pow(2.0, 1.0 / NUMTASKS) - 1.0) * PERCENT;
+    uint32_t utilisation = scheduleUtilisation(demand, isrCycles);
+    size_t index;
+
+    printf("%s\n", title);
+    printf("%-20s %8s %4s %4s %10s %10s %10s %10s %10s %8s\n", "task", "rate Hz", "tier", "prio",
+           "run us", "slice us", "block us", "resp us", "period us", "");
+    for (index = 0; index < NUMTASKS; index++) {
+        printf("%-20s %8.2f %4s %4u %10.0f %10.0f %10.0f ", taskNames[index],
+               (double)simClockHz() / demand[index].periodCycles,
+               demand[index].tier == TIER_HARD ? "hard" : "bg", demand[index].priority,
+               toUs(demand[index].runCycles), toUs(demand[index].sliceCycles),
+               toUs(response[index].blockingCycles));
+        if (response[index].schedulable) {
+            printf("%10.0f", toUs(response[index].responseCycles));
+        } else {
+            printf("%10s", "unbounded");
+        }
+        printf(" %10.0f %8s\n", toUs(demand[index].periodCycles),
+               response[index].schedulable ? "ok" : "MISSES");
+    }
+    printf("interrupts %.0f us per %.0f us tick\n", toUs(isrCycles),
+           (double)US_PER_SECOND / SYSTICK_RATE_HZ);
+    printf("utilisation %.1f%%, Liu and Layland bound for %d tasks %.1f%%\n",
+           utilisation / 10.0, NUMTASKS, bound);
+    printf("priorities %s rate monotonic\n", isRateMonotonic(demand) ? "are" : "are not");
+    printf("%s\n\n", schedulable ? "schedulable" : "NOT SCHEDULABLE");
+    return schedulable;
+}
+
+//*****************************************************************************
+// @param demand Demand to apply the command line changes to
+//*****************************************************************************
+static void
+applyOverrides(taskDemand_t demand[NUMTASKS])
+{
+    size_t index;
+    for (index = 0; index < NUMTASKS; index++) {
+        if (rateOverride[index] > 0) {
+            if (SYSTICK_RATE_HZ % rateOverride[index] != 0) {
+                fprintf(stderr, "warning: %s at %u Hz does not divide the %d Hz tick\n",
+                        taskNames[index], rateOverride[index], SYSTICK_RATE_HZ);
+            }
+            demand[index].periodCycles = simClockHz() / rateOverride[index];
+        }
+        demand[index].runCycles = (uint64_t)demand[index].runCycles * runPercent / PERCENT;
+        demand[index].sliceCycles = (uint64_t)demand[index].sliceCycles * runPercent / PERCENT;
+    }
+}
+
+static void
+usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [-t seconds] [-L land] [-r task=Hz] [-x percent] [-b]\n"
+            "  -t  virtual seconds to fly for the measurements (default %.0f)\n"
+            "  -L  time the takeoff switch goes down, negative to never (default %.0f)\n"
+            "  -r  analyse a task at another rate, by name or index, e.g. CONTROL_TASK=30\n"
+            "  -x  scale the measured run times, e.g. 200 for twice as long (default %d)\n"
+            "  -b  also analyse the run time budgets in tasks.h\n",
+            program, DEFAULT_RUN_SECONDS, DEFAULT_LAND_SECONDS, PERCENT);
+}
+
+int
+main(int argc, char **argv)
+{
+    double runSeconds = DEFAULT_RUN_SECONDS;
+    bool budgets = false;
+    bool schedulable = true;
+    simPlantParams_t params;
+    taskDemand_t demand[NUMTASKS];
+    uint32_t isrCycles;
+    size_t index;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:L:r:x:b")) != -1) {
+        switch (opt) {
+        case 't':
+            runSeconds = atof(optarg);
+            break;
+        case 'L':
+            landSeconds = atof(optarg);
+            break;
+        case 'r':
+            if (!parseRate(optarg)) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'x':
+            runPercent = strtoul(optarg, NULL, 0);
+            break;
+        case 'b':
+            budgets = true;
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    simPlantDefaultParams(&params);
+    simGpioDrive(SW_PORT, SW2_GPIO_PIN | SW1_GPIO_PIN, SW2_GPIO_PIN);
+    simPlantInit(&params);
+    simEventAtSeconds(simEventRegister(takeoffHandler), TAKEOFF_SECONDS);
+    if (landSeconds >= 0) {
+        simEventAtSeconds(simEventRegister(landHandler), landSeconds);
+    }
+    // The firmware's boot check writes to the UART, which is left unconnected
+    if (simRun(firmwareMain, runSeconds) != SIM_STOP_TIME) {
+        fprintf(stderr, "firmware stopped before %.0f s\n", runSeconds);
+        return EXIT_FAILURE;
+    }
+
+    measuredDemand(demand);
+    isrCycles = (uint64_t)getIsrBudget()->worstCycles * runPercent / PERCENT;
+    applyOverrides(demand);
+    for (index = 0; index < NUMTASKS; index++) {
+        if (demand[index].runCycles > taskTable[index].wcetUs * (simClockHz() / US_PER_SECOND)) {
+            printf("%s ran %.0f us, over its %u us budget\n", taskNames[index],
+                   toUs(demand[index].runCycles), taskTable[index].wcetUs);
+        }
+    }
+    schedulable = report("Measured over the flight", demand, isrCycles) && schedulable;
+
+    if (budgets) {
+        budgetDemand(demand);
+        applyOverrides(demand);
+        isrCycles = (uint64_t)ISR_BUDGET_US * (simClockHz() / US_PER_SECOND) * runPercent / PERCENT;
+        schedulable = report("Budgets from tasks.h", demand, isrCycles) && schedulable;
+    }
+    return schedulable ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,357 @@
+/*
+ * heliSim.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host entry point that runs the unmodified helicopter firmware as a
+ *      Linux process on the simulated Tiva board. The rig holds the reset line high,
+ *      flips the takeoff switch at the requested times and closes the loop through the
+ *      rig model, so a flight runs on the virtual clock far faster than real time. The
+ *      rig inputs can be recorded and replayed in place of the model, and the outputs
+ *      are hashed so a replay can be checked for a bit-exact match. Commands can be
+ *      typed into the UART at set times, as an operator would on the rig.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim/simCore.h"
+#include "sim/simAdcMode.h"
+#include "sim/simGains.h"
+#include "sim/simHardware.h"
+#include "sim/simPlant.h"
+#include "sim/simTrace.h"
+#include "adcDma.h"
+#include "cpuLoad.h"
+#include "pwm.h"
+#include "states.h"
+#include "switches.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define DEFAULT_RUN_SECONDS 30.0
+#define DEFAULT_TAKEOFF_SECONDS 1.0
+#define TRACE_RATE_HZ 50
+#define STATE_POLL_HZ 1000
+#define REPLAY_RUN_SECONDS 1e9      // Replays run until the recording ends
+#define MAX_COMMANDS 16
+#define COMMAND_TEXT_LEN 64
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static double takeoffSeconds = DEFAULT_TAKEOFF_SECONDS;
+static double landSeconds = -1;
+static int takeoffEvent;
+static int landEvent;
+static int traceEvent;
+static uint64_t traceCount;
+static FILE *traceFile;
+static FILE *recordFile;
+static FILE *replayFile;
+static FILE *outputFile;
+static int stateEvent;
+static uint64_t statePolls;
+static helicopterState_t lastState = (helicopterState_t)-1;
+
+// Lines typed into the UART, in time order from nextCommand
+typedef struct {
+    double seconds;
+    char text[COMMAND_TEXT_LEN];
+} uartCommand_t;
+static uartCommand_t commands[MAX_COMMANDS];
+static size_t numCommands;
+static size_t nextCommand;
+static int commandEvent;
+
+//*****************************************************************************
+// The firmware main() from finalMain.c, renamed by the host build
+//*****************************************************************************
+int firmwareMain(void);
+
+//*****************************************************************************
+// Rig switch SW1 moved up, asking the helicopter to take off
+//*****************************************************************************
+static void
+takeoffHandler(void)
+{
+    simGpioDrive(SW_PORT, SW1_GPIO_PIN, SW1_GPIO_PIN);
+}
+
+//*****************************************************************************
+// Rig switch SW1 moved down, asking the helicopter to land
+//*****************************************************************************
+static void
+landHandler(void)
+{
+    simGpioDrive(SW_PORT, SW1_GPIO_PIN, 0);
+}
+
+//*****************************************************************************
+// Writes one line of the flight trace
+//*****************************************************************************
+static void
+traceHandler(void)
+{
+    simPlantState_t plant = simPlantState();
+    fprintf(traceFile, "%.3f,%s,%.2f,%.2f,%.1f,%.1f,%d,%d\n", simSeconds(), heliStateStr(),
+            plant.altitude, plant.yaw, plant.mainDuty, plant.tailDuty,
+            getAltitudeSetpoint(), getYawSetpoint());
+    traceCount++;
+    simEventAtSeconds(traceEvent, (double)traceCount / TRACE_RATE_HZ);
+}
+
+//*****************************************************************************
+// Reports state machine transitions to the output trace
+//*****************************************************************************
+static void
+stateHandler(void)
+{
+    if (getState() != lastState) {
+        lastState = getState();
+        simTraceOutput("state %s", heliStateStr());
+    }
+    statePolls++;
+    simEventAtSeconds(stateEvent, (double)statePolls / STATE_POLL_HZ);
+}
+
+//*****************************************************************************
+// Types the next command into the UART and schedules the one after
+//*****************************************************************************
+static void
+commandHandler(void)
+{
+    simUartReceive(commands[nextCommand].text);
+    nextCommand++;
+    if (nextCommand < numCommands) {
+        simEventAtSeconds(commandEvent, commands[nextCommand].seconds);
+    }
+}
+
+//*****************************************************************************
+// @param arg Option of the form seconds:command
+//
+// @return bool False if the option is not understood or too many were given
+//*****************************************************************************
+static bool
+parseCommand(const char *arg)
+{
+    const char *colon = strchr(arg, ':');
+    uartCommand_t *command = &commands[numCommands];
+    size_t slot;
+
+    if (colon == NULL || numCommands == MAX_COMMANDS
+            || strlen(colon + 1) + 2 > sizeof(command->text)) {
+        return false;
+    }
+    command->seconds = atof(arg);
+    snprintf(command->text, sizeof(command->text), "%s\r", colon + 1);
+    // Keep the commands in time order, options for the same time in the order given
+    for (slot = numCommands; slot > 0 && commands[slot - 1].seconds > command->seconds; slot--) {
+        uartCommand_t swap = commands[slot - 1];
+        commands[slot - 1] = commands[slot];
+        commands[slot] = swap;
+    }
+    numCommands++;
+    return true;
+}
+
+//*****************************************************************************
+// @param path File to open
+//
+// @param mode fopen() mode
+//
+// @return FILE* The open file. Exits if it cannot be opened.
+//*****************************************************************************
+static FILE *
+openFile(const char *path, const char *mode)
+{
+    FILE *file = fopen(path, mode);
+    if (file == NULL) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    return file;
+}
+
+//*****************************************************************************
+// Puts the rig into its power-on state: reset line idle high, takeoff switch
+// down and the helicopter resting on the ground
+//*****************************************************************************
+static void
+initRig(const simPlantParams_t *params)
+{
+    stateEvent = simEventRegister(stateHandler);
+    simEventAtSeconds(stateEvent, 0);
+    if (traceFile != NULL) {
+        fprintf(traceFile, "time,state,altitude,yaw,main_duty,tail_duty,"
+                "altitude_setpoint,yaw_setpoint\n");
+        traceEvent = simEventRegister(traceHandler);
+        simEventAtSeconds(traceEvent, 0);
+    }
+    // Commands are not recorded, so a replay needs the same -c options
+    if (numCommands > 0) {
+        commandEvent = simEventRegister(commandHandler);
+        simEventAtSeconds(commandEvent, commands[0].seconds);
+    }
+    // A replayed recording holds every input, switches included
+    if (replayFile != NULL) {
+        simTraceReplay(replayFile);
+        return;
+    }
+    if (recordFile != NULL) {
+        simTraceRecord(recordFile);
+    }
+    simGpioDrive(SW_PORT, SW2_GPIO_PIN | SW1_GPIO_PIN, SW2_GPIO_PIN);
+    simPlantInit(params);
+    takeoffEvent = simEventRegister(takeoffHandler);
+    landEvent = simEventRegister(landHandler);
+    if (takeoffSeconds >= 0) {
+        simEventAtSeconds(takeoffEvent, takeoffSeconds);
+    }
+    if (landSeconds >= 0) {
+        simEventAtSeconds(landEvent, landSeconds);
+    }
+}
+
+static void
+usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [-t seconds] [-T takeoff] [-L land] [-s seed] [-g gains] [-o trace.csv]\n"
+            "       [-R inputs] [-P inputs] [-O outputs] [-c seconds:command] [-a mode] [-u]\n"
+            "  -t  virtual seconds to run (default %.0f)\n"
+            "  -T  time the takeoff switch goes up, negative to never (default %.0f)\n"
+            "  -L  time the takeoff switch goes down, negative to never (default never)\n"
+            "  -s  seed for the sensor noise\n"
+            "  -g  controller gains as Kp alt,Ki alt,Kp yaw,Ki yaw,Kd yaw, e.g. from heliTune\n"
+            "  -o  write a CSV trace of the flight\n"
+            "  -R  record the rig inputs to a file\n"
+            "  -P  replay recorded rig inputs instead of the rig model, until the recording ends\n"
+            "  -O  write every PWM and state change to a file\n"
+            "  -c  type a command into the UART at a time, e.g. \"5:rate 3 5\", repeatable\n"
+            "  -a  sample the altitude in a burst per sample (burst) or by uDMA in blocks (dma)\n"
+            "  -u  copy UART telemetry to stdout\n",
+            program, DEFAULT_RUN_SECONDS, DEFAULT_TAKEOFF_SECONDS);
+}
+
+int
+main(int argc, char **argv)
+{
+    double runSeconds = DEFAULT_RUN_SECONDS;
+    bool runSet = false;
+    simPlantParams_t params;
+    simPlantState_t plant;
+    static const char *stopNames[] = {"", "time", "reset", "halt"};
+    clock_t start;
+    double hostSeconds;
+    size_t task;
+    int reason;
+    int opt;
+
+    simPlantDefaultParams(&params);
+    while ((opt = getopt(argc, argv, "t:T:L:s:g:o:R:P:O:c:a:u")) != -1) {
+        switch (opt) {
+        case 't':
+            runSeconds = atof(optarg);
+            runSet = true;
+            break;
+        case 'T':
+            takeoffSeconds = atof(optarg);
+            break;
+        case 'L':
+            landSeconds = atof(optarg);
+            break;
+        case 's':
+            params.seed = strtoul(optarg, NULL, 0);
+            break;
+        case 'g':
+            if (sscanf(optarg, "%d,%d,%d,%d,%d", &simGains.kpAltitude, &simGains.kiAltitude,
+                       &simGains.kpYaw, &simGains.kiYaw, &simGains.kdYaw) != 5) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'o':
+            traceFile = openFile(optarg, "w");
+            break;
+        case 'R':
+            recordFile = openFile(optarg, "w");
+            break;
+        case 'P':
+            replayFile = openFile(optarg, "r");
+            if (!runSet) {
+                runSeconds = REPLAY_RUN_SECONDS;
+            }
+            break;
+        case 'O':
+            outputFile = openFile(optarg, "w");
+            simTraceOutputs(outputFile);
+            break;
+        case 'c':
+            if (!parseCommand(optarg)) {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'a':
+            if (strcmp(optarg, "burst") == 0) {
+                simAdcMode = ADC_MODE_BURST;
+            } else if (strcmp(optarg, "dma") == 0) {
+                simAdcMode = ADC_MODE_DMA;
+            } else {
+                usage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'u':
+            simUartSetOutput(stdout);
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    initRig(&params);
+    start = clock();
+    reason = simRun(firmwareMain, runSeconds);
+    hostSeconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("stopped: %s after %.3f s virtual, %.3f s host (%.0fx real time)\n",
+           stopNames[reason], simSeconds(), hostSeconds,
+           hostSeconds > 0 ? simSeconds() / hostSeconds : 0);
+    simTraceFinish();
+    plant = simPlantState();
+    printf("state: %s, main duty %.1f%%, tail duty %.1f%%", heliStateStr(),
+           simPwmDuty(PWM_ALTITUDE_BASE, PWM_ALTITUDE_OUTNUM),
+           simPwmDuty(PWM_YAW_BASE, PWM_YAW_OUTNUM));
+    if (replayFile == NULL) {
+        printf(", altitude %.1f%%, yaw %.1f deg", plant.altitude, plant.yaw);
+    }
+    printf("\ncpu load: 1s %.1f%%, 10s %.1f%%, tasks over 10s",
+           getCpuLoad(LOAD_1S) / 10.0, getCpuLoad(LOAD_10S) / 10.0);
+    for (task = 0; task < NUMTASKS; task++) {
+        printf(" %.1f%%", getTaskLoad(task, LOAD_10S) / 10.0);
+    }
+    if (simAdcMode == ADC_MODE_DMA) {
+        printf("\nadc dma: %u blocks, %u overruns", getAdcDmaBlocks(), getAdcDmaOverruns());
+    }
+    printf("\noutputs: %llu changes, hash %016llx\n",
+           (unsigned long long)simTraceOutputCount(),
+           (unsigned long long)simTraceOutputHash());
+    if (traceFile != NULL) {
+        fclose(traceFile);
+    }
+    if (recordFile != NULL) {
+        fclose(recordFile);
+    }
+    if (replayFile != NULL) {
+        fclose(replayFile);
+    }
+    if (outputFile != NULL) {
+        fclose(outputFile);
+    }
+    return reason == SIM_STOP_TIME ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,732 @@
+/*
+ * heliTune.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host tool that tunes the PID gains in pidController.h by flying the
+ *      unmodified firmware against the rig model many times over. Each flight runs in
+ *      its own forked process, as many at once as there are cores. A grid search over
+ *      the gain space seeds a compass search from the best few points, every flight is
+ *      scored on overshoot, settling time and actuator effort, and the results are
+ *      written out as a ranked report.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "sim/simCore.h"
+#include "sim/simGains.h"
+#include "sim/simHardware.h"
+#include "sim/simPlant.h"
+#include "buttons4.h"
+#include "pwm.h"
+#include "states.h"
+#include "switches.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define TAKEOFF_SECONDS 1.0
+#define FIRST_STEP_SECONDS 15.0     // The helicopter must be flying by now
+#define STEP_SECONDS 10.0           // Time allowed for each step to settle
+#define PRESS_SECONDS 0.25          // Long enough for the 5 Hz button task to see it
+#define METRIC_RATE_HZ 100
+
+#define ALTITUDE_BAND 2.0           // Settled within +/- 2% altitude
+#define YAW_BAND 3.0                // Settled within +/- 3 degrees
+#define SETTLE_HOLD_SECONDS 1.0     // Time in the band at the end of a step to count as settled
+
+#define OVERSHOOT_WEIGHT 0.1        // Score per % of the step
+#define SETTLING_WEIGHT 1.0         // Score per second
+#define EFFORT_WEIGHT 0.01          // Score per %/s of duty movement
+#define FAILED_SCORE 1e6
+
+#define NUM_GAINS 5
+#define MAX_GAIN 100
+#define MAX_LOCAL_ITERATIONS 50
+#define DEFAULT_REPORT_ROWS 20
+#define DEFAULT_LOCAL_STARTS 3
+
+//*****************************************************************************
+// Structs
+//*****************************************************************************
+typedef struct {
+    double seconds;
+    uint8_t button;
+} tuneStep_t;
+
+typedef struct {
+    int32_t min;
+    int32_t max;
+    int32_t step;
+} gainRange_t;
+
+typedef struct {
+    double score;
+    double altitudeOvershoot;   // Mean overshoot of the altitude steps, % of the step
+    double altitudeSettling;    // Mean settling time of the altitude steps (s)
+    double yawOvershoot;
+    double yawSettling;
+    double effort;              // Total movement of both duty cycles per second (%/s)
+    int failures;               // Flights that never flew or stopped early
+    int unsettled;              // Steps still leaving their band at the end of the window
+} flightResult_t;
+
+typedef struct {
+    simGains_t gains;
+    flightResult_t result;
+    const char *phase;
+} candidate_t;
+
+typedef struct {
+    candidate_t *candidate;
+    uint32_t seed;
+    flightResult_t result;
+} job_t;
+
+//*****************************************************************************
+// The set point changes every flight is scored on, one axis at a time
+//*****************************************************************************
+static const tuneStep_t steps[] = {
+    {FIRST_STEP_SECONDS, UP},
+    {FIRST_STEP_SECONDS + STEP_SECONDS, RIGHT},
+    {FIRST_STEP_SECONDS + 2 * STEP_SECONDS, DOWN},
+    {FIRST_STEP_SECONDS + 3 * STEP_SECONDS, LEFT},
+};
+#define NUM_STEPS (sizeof(steps) / sizeof(steps[0]))
+#define FLIGHT_SECONDS (FIRST_STEP_SECONDS + NUM_STEPS * STEP_SECONDS)
+
+// Grid searched before the local search, in the order of simGains_t
+static const gainRange_t grid[NUM_GAINS] = {
+    {2, 10, 2},     // kpAltitude
+    {0, 4, 1},      // kiAltitude
+    {4, 20, 4},     // kpYaw
+    {0, 4, 2},      // kiYaw
+    {0, 8, 2},      // kdYaw
+};
+static const char *gainNames[NUM_GAINS] = {"Kp alt", "Ki alt", "Kp yaw", "Ki yaw", "Kd yaw"};
+
+//*****************************************************************************
+// Flight state, only used inside the forked process flying it
+//*****************************************************************************
+static uint32_t stepIndex;
+static bool pressed;
+static int takeoffEvent;
+static int buttonEvent;
+static int metricEvent;
+static uint64_t metricCount;
+static double stepStart[NUM_STEPS];         // Set point before each step
+static double stepOvershoot[NUM_STEPS];
+static double stepSettled[NUM_STEPS];       // Last time outside the band
+static double stepLateError[NUM_STEPS];     // Largest error in the last SETTLE_HOLD_SECONDS, in bands
+static bool stepMoved[NUM_STEPS];           // The firmware saw the button press
+static double lastMainDuty;
+static double lastTailDuty;
+static double dutyTravel;
+static bool flying;
+
+//*****************************************************************************
+// Search state, in the parent
+//*****************************************************************************
+static candidate_t *candidates;
+static size_t numCandidates;
+static size_t maxCandidates;
+static int numWorkers;
+static int numSeeds = 1;
+static size_t flights;
+
+//*****************************************************************************
+// The firmware main() from finalMain.c, renamed by the host build
+//*****************************************************************************
+int firmwareMain(void);
+
+static int32_t *
+gainAt(simGains_t *gains, int index)
+{
+    return &((int32_t *)gains)[index];
+}
+
+//*****************************************************************************
+// @param button Button from butNames
+//
+// @param press True to hold the button, false to let it go
+//*****************************************************************************
+static void
+setButton(uint8_t button, bool press)
+{
+    static const uint32_t bases[NUM_BUTS] = {UP_BUT_PORT_BASE, DOWN_BUT_PORT_BASE,
+                                             LEFT_BUT_PORT_BASE, RIGHT_BUT_PORT_BASE};
+    static const uint8_t pins[NUM_BUTS] = {UP_BUT_PIN, DOWN_BUT_PIN,
+                                           LEFT_BUT_PIN, RIGHT_BUT_PIN};
+    static const bool normals[NUM_BUTS] = {UP_BUT_NORMAL, DOWN_BUT_NORMAL,
+                                           LEFT_BUT_NORMAL, RIGHT_BUT_NORMAL};
+    if (press) {
+        simGpioDrive(bases[button], pins[button], normals[button] ? 0 : pins[button]);
+    } else {
+        simGpioRelease(bases[button], pins[button]);
+    }
+}
+
+static bool
+isYawStep(uint32_t index)
+{
+    return steps[index].button == LEFT || steps[index].button == RIGHT;
+}
+
+static double
+stepDirection(uint32_t index)
+{
+    return steps[index].button == UP || steps[index].button == RIGHT ? 1.0 : -1.0;
+}
+
+static void
+takeoffHandler(void)
+{
+    simGpioDrive(SW_PORT, SW1_GPIO_PIN, SW1_GPIO_PIN);
+}
+
+//*****************************************************************************
+// Presses and releases the buttons through the step list
+//*****************************************************************************
+static void
+buttonHandler(void)
+{
+    if (!pressed) {
+        stepStart[stepIndex] = isYawStep(stepIndex) ? getYawSetpoint() : getAltitudeSetpoint();
+        setButton(steps[stepIndex].button, true);
+        pressed = true;
+        simEventAtSeconds(buttonEvent, steps[stepIndex].seconds + PRESS_SECONDS);
+    } else {
+        setButton(steps[stepIndex].button, false);
+        pressed = false;
+        stepIndex++;
+        if (stepIndex < NUM_STEPS) {
+            simEventAtSeconds(buttonEvent, steps[stepIndex].seconds);
+        }
+    }
+}
+
+//*****************************************************************************
+// Samples the rig against the firmware set points for the step in progress
+//*****************************************************************************
+static void
+metricHandler(void)
+{
+    simPlantState_t plant = simPlantState();
+    double now = simSeconds();
+
+    if (now >= FIRST_STEP_SECONDS) {
+        int32_t current = pressed ? (int32_t)stepIndex : (int32_t)stepIndex - 1;
+        if (current >= 0) {
+            double target;
+            double error;
+            double band;
+            if (isYawStep(current)) {
+                target = getYawSetpoint();
+                error = fmod(plant.yaw - target + 540.0, 360.0) - 180.0;
+                band = YAW_BAND;
+            } else {
+                target = getAltitudeSetpoint();
+                error = plant.altitude - target;
+                band = ALTITUDE_BAND;
+            }
+            // Wait for the button task to move the set point
+            if (target != stepStart[current]) {
+                stepMoved[current] = true;
+                if (error * stepDirection(current) > stepOvershoot[current]) {
+                    stepOvershoot[current] = error * stepDirection(current);
+                }
+            }
+            if (fabs(error) > band || !stepMoved[current]) {
+                stepSettled[current] = now - steps[current].seconds;
+            }
+            if (now - steps[current].seconds >= STEP_SECONDS - SETTLE_HOLD_SECONDS
+                    && fabs(error) / band > stepLateError[current]) {
+                stepLateError[current] = fabs(error) / band;
+            }
+        }
+        dutyTravel += fabs(plant.mainDuty - lastMainDuty) + fabs(plant.tailDuty - lastTailDuty);
+    } else if (now >= FIRST_STEP_SECONDS - 1.0 / METRIC_RATE_HZ) {
+        flying = getState() == FLYING;
+    }
+    lastMainDuty = plant.mainDuty;
+    lastTailDuty = plant.tailDuty;
+    metricCount++;
+    simEventAtSeconds(metricEvent, (double)metricCount / METRIC_RATE_HZ);
+}
+
+//*****************************************************************************
+// @param gains Controller gains to fly with
+//
+// @param seed Sensor noise seed
+//
+// @return flightResult_t The scored flight. Only call once per process, the
+// firmware cannot be restarted.
+//*****************************************************************************
+static flightResult_t
+fly(const simGains_t *gains, uint32_t seed)
+{
+    flightResult_t result = {0};
+    simPlantParams_t params;
+    uint32_t altitudeSteps = 0;
+    uint32_t yawSteps = 0;
+    uint32_t i;
+    int reason;
+
+    simGains = *gains;
+    simPlantDefaultParams(&params);
+    params.seed = seed;
+    simGpioDrive(SW_PORT, SW2_GPIO_PIN | SW1_GPIO_PIN, SW2_GPIO_PIN);
+    simPlantInit(&params);
+    takeoffEvent = simEventRegister(takeoffHandler);
+    buttonEvent = simEventRegister(buttonHandler);
+    metricEvent = simEventRegister(metricHandler);
+    simEventAtSeconds(takeoffEvent, TAKEOFF_SECONDS);
+    simEventAtSeconds(buttonEvent, steps[0].seconds);
+    simEventAtSeconds(metricEvent, 0);
+
+    reason = simRun(firmwareMain, FLIGHT_SECONDS);
+    if (reason != SIM_STOP_TIME || !flying) {
+        result.failures = 1;
+        result.score = FAILED_SCORE;
+        return result;
+    }
+
+    for (i = 0; i < NUM_STEPS; i++) {
+        if (!stepMoved[i]) {
+            result.failures = 1;
+            result.score = FAILED_SCORE;
+            return result;
+        }
+    }
+    for (i = 0; i < NUM_STEPS; i++) {
+        double size = fabs(isYawStep(i) ? YAW_INCREASE : ALTITUDE_INCREASE);
+        double overshoot = stepOvershoot[i] / size * 100.0;
+        double settling = stepSettled[i];
+        // A step that only passes through the band as its window ends has not settled.
+        // It scores a window for each band its error still reaches, so it ranks below
+        // every step that settled and larger oscillations rank lower.
+        if (stepLateError[i] > 1.0) {
+            settling = STEP_SECONDS * stepLateError[i];
+            result.unsettled++;
+        }
+        if (isYawStep(i)) {
+            result.yawOvershoot += overshoot;
+            result.yawSettling += settling;
+            yawSteps++;
+        } else {
+            result.altitudeOvershoot += overshoot;
+            result.altitudeSettling += settling;
+            altitudeSteps++;
+        }
+    }
+    result.altitudeOvershoot /= altitudeSteps;
+    result.altitudeSettling /= altitudeSteps;
+    result.yawOvershoot /= yawSteps;
+    result.yawSettling /= yawSteps;
+    result.effort = dutyTravel / (FLIGHT_SECONDS - FIRST_STEP_SECONDS);
+    result.score = OVERSHOOT_WEIGHT * (result.altitudeOvershoot + result.yawOvershoot) / 2
+                   + SETTLING_WEIGHT * (result.altitudeSettling + result.yawSettling) / 2
+                   + EFFORT_WEIGHT * result.effort;
+    return result;
+}
+
+//*****************************************************************************
+// @param jobs Flights to run, filled in with their results
+//
+// @param numJobs Number of flights
+//
+// Forks a process per flight, keeping numWorkers of them running at once
+//*****************************************************************************
+static void
+runJobs(job_t *jobs, size_t numJobs)
+{
+    pid_t *pids = calloc(numWorkers, sizeof(pid_t));
+    int *pipes = calloc(numWorkers, sizeof(int));
+    size_t *owners = calloc(numWorkers, sizeof(size_t));
+    size_t next = 0;
+    int running = 0;
+    int slot;
+
+    fflush(stdout);
+    fflush(stderr);
+    while (next < numJobs || running > 0) {
+        for (slot = 0; slot < numWorkers && next < numJobs; slot++) {
+            int fds[2];
+            if (pids[slot] != 0) {
+                continue;
+            }
+            if (pipe(fds) != 0) {
+                perror("pipe");
+                exit(EXIT_FAILURE);
+            }
+            pids[slot] = fork();
+            if (pids[slot] < 0) {
+                perror("fork");
+                exit(EXIT_FAILURE);
+            }
+            if (pids[slot] == 0) {
+                flightResult_t result;
+                close(fds[0]);
+                result = fly(&jobs[next].candidate->gains, jobs[next].seed);
+                // Smaller than PIPE_BUF, so this never blocks
+                if (write(fds[1], &result, sizeof(result)) != sizeof(result)) {
+                    _exit(EXIT_FAILURE);
+                }
+                _exit(EXIT_SUCCESS);
+            }
+            close(fds[1]);
+            pipes[slot] = fds[0];
+            owners[slot] = next++;
+            running++;
+        }
+
+        pid_t pid = wait(NULL);
+        for (slot = 0; slot < numWorkers; slot++) {
+            if (pids[slot] == pid && pid > 0) {
+                job_t *job = &jobs[owners[slot]];
+                if (read(pipes[slot], &job->result, sizeof(job->result))
+                        != sizeof(job->result)) {
+                    // The flight crashed
+                    memset(&job->result, 0, sizeof(job->result));
+                    job->result.failures = 1;
+                    job->result.score = FAILED_SCORE;
+                }
+                close(pipes[slot]);
+                pids[slot] = 0;
+                running--;
+                flights++;
+            }
+        }
+    }
+    free(pids);
+    free(pipes);
+    free(owners);
+}
+
+//*****************************************************************************
+// @return candidate_t* The candidate already flown with these gains, or NULL
+//*****************************************************************************
+static candidate_t *
+findCandidate(const simGains_t *gains)
+{
+    size_t i;
+    for (i = 0; i < numCandidates; i++) {
+        if (memcmp(&candidates[i].gains, gains, sizeof(*gains)) == 0) {
+            return &candidates[i];
+        }
+    }
+    return NULL;
+}
+
+//*****************************************************************************
+// @param gains Gain sets to evaluate, duplicates and ones already flown are skipped
+//
+// @param count Number of gain sets
+//
+// @param phase Search phase recorded in the report
+//
+// Flies every new gain set once per seed in parallel and records the mean result
+//*****************************************************************************
+static void
+evaluate(const simGains_t *gains, size_t count, const char *phase)
+{
+    size_t first = numCandidates;
+    size_t numJobs;
+    job_t *jobs;
+    size_t i;
+
+    if (numCandidates + count > maxCandidates) {
+        maxCandidates = (numCandidates + count) * 2;
+        candidates = realloc(candidates, maxCandidates * sizeof(candidate_t));
+    }
+    for (i = 0; i < count; i++) {
+        if (findCandidate(&gains[i]) == NULL) {
+            memset(&candidates[numCandidates], 0, sizeof(candidate_t));
+            candidates[numCandidates].gains = gains[i];
+            candidates[numCandidates].phase = phase;
+            numCandidates++;
+        }
+    }
+
+    numJobs = (numCandidates - first) * numSeeds;
+    jobs = calloc(numJobs ? numJobs : 1, sizeof(job_t));
+    for (i = 0; i < numJobs; i++) {
+        jobs[i].candidate = &candidates[first + i / numSeeds];
+        jobs[i].seed = 1 + i % numSeeds;
+    }
+    runJobs(jobs, numJobs);
+
+    for (i = 0; i < numJobs; i++) {
+        flightResult_t *sum = &jobs[i].candidate->result;
+        flightResult_t *run = &jobs[i].result;
+        sum->score += run->score / numSeeds;
+        sum->altitudeOvershoot += run->altitudeOvershoot / numSeeds;
+        sum->altitudeSettling += run->altitudeSettling / numSeeds;
+        sum->yawOvershoot += run->yawOvershoot / numSeeds;
+        sum->yawSettling += run->yawSettling / numSeeds;
+        sum->effort += run->effort / numSeeds;
+        sum->failures += run->failures;
+        sum->unsettled += run->unsettled;
+    }
+    free(jobs);
+}
+
+static int
+compareCandidates(const void *a, const void *b)
+{
+    double scoreA = ((const candidate_t *)a)->result.score;
+    double scoreB = ((const candidate_t *)b)->result.score;
+    return (scoreA > scoreB) - (scoreA < scoreB);
+}
+
+//*****************************************************************************
+// Flies every point of the gain grid
+//*****************************************************************************
+static void
+gridSearch(void)
+{
+    size_t count = 1;
+    simGains_t *points;
+    size_t i;
+    int g;
+
+    for (g = 0; g < NUM_GAINS; g++) {
+        count *= (grid[g].max - grid[g].min) / grid[g].step + 1;
+    }
+    points = malloc(count * sizeof(simGains_t));
+    for (i = 0; i < count; i++) {
+        size_t index = i;
+        for (g = 0; g < NUM_GAINS; g++) {
+            size_t levels = (grid[g].max - grid[g].min) / grid[g].step + 1;
+            *gainAt(&points[i], g) = grid[g].min + (int32_t)(index % levels) * grid[g].step;
+            index /= levels;
+        }
+    }
+    evaluate(points, count, "grid");
+    free(points);
+}
+
+//*****************************************************************************
+// @param numStarts Number of the best points so far to search from
+//
+// Compass search on the integer gains from each start, all searches stepping
+// together so every batch of flights keeps the cores busy. A search moves to
+// its best neighbour while that improves the score and halves its step when
+// none does, finishing once a step of one finds nothing better.
+//*****************************************************************************
+static void
+localSearch(int numStarts)
+{
+    simGains_t *centres = calloc(numStarts, sizeof(simGains_t));
+    int32_t (*stepSizes)[NUM_GAINS] = calloc(numStarts, sizeof(*stepSizes));
+    bool *done = calloc(numStarts, sizeof(bool));
+    simGains_t *neighbours = calloc(numStarts * NUM_GAINS * 2, sizeof(simGains_t));
+    int iteration;
+    int s;
+    int g;
+
+    qsort(candidates, numCandidates, sizeof(candidate_t), compareCandidates);
+    if ((size_t)numStarts > numCandidates) {
+        numStarts = numCandidates;
+    }
+    for (s = 0; s < numStarts; s++) {
+        centres[s] = candidates[s].gains;
+        for (g = 0; g < NUM_GAINS; g++) {
+            stepSizes[s][g] = grid[g].step > 1 ? grid[g].step / 2 : 1;
+        }
+    }
+
+    for (iteration = 0; iteration < MAX_LOCAL_ITERATIONS; iteration++) {
+        size_t count = 0;
+        bool active = false;
+        for (s = 0; s < numStarts; s++) {
+            if (done[s]) {
+                continue;
+            }
+            active = true;
+            for (g = 0; g < NUM_GAINS * 2; g++) {
+                simGains_t point = centres[s];
+                int32_t *gain = gainAt(&point, g / 2);
+                *gain += g % 2 ? stepSizes[s][g / 2] : -stepSizes[s][g / 2];
+                if (*gain >= 0 && *gain <= MAX_GAIN) {
+                    neighbours[count++] = point;
+                }
+            }
+        }
+        if (!active) {
+            break;
+        }
+        evaluate(neighbours, count, "local");
+
+        for (s = 0; s < numStarts; s++) {
+            candidate_t *best;
+            bool shrunk = false;
+            if (done[s]) {
+                continue;
+            }
+            best = findCandidate(&centres[s]);
+            for (g = 0; g < NUM_GAINS * 2; g++) {
+                simGains_t point = centres[s];
+                candidate_t *neighbour;
+                *gainAt(&point, g / 2) += g % 2 ? stepSizes[s][g / 2] : -stepSizes[s][g / 2];
+                neighbour = findCandidate(&point);
+                if (neighbour != NULL && neighbour->result.score < best->result.score) {
+                    best = neighbour;
+                }
+            }
+            if (memcmp(&best->gains, &centres[s], sizeof(simGains_t)) != 0) {
+                centres[s] = best->gains;
+                continue;
+            }
+            for (g = 0; g < NUM_GAINS; g++) {
+                if (stepSizes[s][g] > 1) {
+                    stepSizes[s][g] /= 2;
+                    shrunk = true;
+                }
+            }
+            done[s] = !shrunk;
+        }
+    }
+    free(centres);
+    free(stepSizes);
+    free(done);
+    free(neighbours);
+}
+
+//*****************************************************************************
+// @param out Stream to write the report to
+//
+// @param rows Number of candidates to list
+//
+// @param seconds Wall clock time the search took
+//*****************************************************************************
+static void
+writeReport(FILE *out, size_t rows, double seconds)
+{
+    const candidate_t *firmware;
+    size_t firmwareRank = 0;
+    size_t i;
+    int g;
+
+    qsort(candidates, numCandidates, sizeof(candidate_t), compareCandidates);
+    firmware = findCandidate(&simFirmwareGains);
+    if (firmware != NULL) {
+        firmwareRank = firmware - candidates + 1;
+    }
+
+    fprintf(out, "PID gain search: %zu gain sets, %zu flights of %.0f s, %d seeds, "
+            "%d workers, %.1f s\n", numCandidates, flights, FLIGHT_SECONDS, numSeeds,
+            numWorkers, seconds);
+    fprintf(out, "Steps: altitude +%d%% and %d%%, yaw +%d and %d deg, %.0f s each\n",
+            ALTITUDE_INCREASE, ALTITUDE_DECREASE, YAW_INCREASE, YAW_DECREASE, STEP_SECONDS);
+    fprintf(out, "Score = %.2f x overshoot %% + %.2f x settling s + %.2f x effort %%/s, "
+            "averaged over both axes\n", OVERSHOOT_WEIGHT, SETTLING_WEIGHT, EFFORT_WEIGHT);
+    fprintf(out, "Settled within +/-%.0f%% altitude and +/-%.0f deg yaw for the last %.0f s of "
+            "the step, an unsettled step counts %.0f s per band its error reaches\n\n",
+            ALTITUDE_BAND, YAW_BAND, SETTLE_HOLD_SECONDS, STEP_SECONDS);
+
+    fprintf(out, "%4s ", "rank");
+    for (g = 0; g < NUM_GAINS; g++) {
+        fprintf(out, "%6s ", gainNames[g]);
+    }
+    fprintf(out, "%8s %9s %9s %9s %9s %8s %5s %5s %s\n", "score", "alt os%", "alt set",
+            "yaw os%", "yaw set", "effort", "unset", "fail", "phase");
+    for (i = 0; i < numCandidates; i++) {
+        const candidate_t *c = &candidates[i];
+        if (i >= rows && c != firmware) {
+            continue;
+        }
+        fprintf(out, "%4zu ", i + 1);
+        for (g = 0; g < NUM_GAINS; g++) {
+            fprintf(out, "%6d ", *gainAt((simGains_t *)&c->gains, g));
+        }
+        fprintf(out, "%8.2f %9.1f %9.2f %9.1f %9.2f %8.1f %5d %5d %s%s\n", c->result.score,
+                c->result.altitudeOvershoot, c->result.altitudeSettling,
+                c->result.yawOvershoot, c->result.yawSettling, c->result.effort,
+                c->result.unsettled, c->result.failures, c->phase,
+                c == firmware ? " (firmware)" : "");
+    }
+    if (firmware != NULL) {
+        fprintf(out, "\nFirmware gains rank %zu of %zu\n", firmwareRank, numCandidates);
+    }
+}
+
+static void
+usage(const char *program)
+{
+    fprintf(stderr, "usage: %s [-j workers] [-r seeds] [-k starts] [-n rows] [-o report]\n"
+            "  -j  flights to run at once (default one per core)\n"
+            "  -r  noise seeds each gain set is flown with (default 1)\n"
+            "  -k  best grid points to start the local search from (default %d)\n"
+            "  -n  rows in the report (default %d)\n"
+            "  -o  write the report to a file instead of stdout\n",
+            program, DEFAULT_LOCAL_STARTS, DEFAULT_REPORT_ROWS);
+}
+
+int
+main(int argc, char **argv)
+{
+    int localStarts = DEFAULT_LOCAL_STARTS;
+    size_t rows = DEFAULT_REPORT_ROWS;
+    const char *reportPath = NULL;
+    FILE *report = stdout;
+    struct timespec start;
+    struct timespec end;
+    double seconds;
+    int opt;
+
+    numWorkers = sysconf(_SC_NPROCESSORS_ONLN);
+    while ((opt = getopt(argc, argv, "j:r:k:n:o:")) != -1) {
+        switch (opt) {
+        case 'j':
+            numWorkers = atoi(optarg);
+            break;
+        case 'r':
+            numSeeds = atoi(optarg);
+            break;
+        case 'k':
+            localStarts = atoi(optarg);
+            break;
+        case 'n':
+            rows = strtoul(optarg, NULL, 0);
+            break;
+        case 'o':
+            reportPath = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (numWorkers < 1 || numSeeds < 1 || localStarts < 0) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    evaluate(&simFirmwareGains, 1, "firmware");
+    gridSearch();
+    fprintf(stderr, "grid search: %zu flights\n", flights);
+    localSearch(localStarts);
+    fprintf(stderr, "local search: %zu flights\n", flights);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    if (reportPath != NULL) {
+        report = fopen(reportPath, "w");
+        if (report == NULL) {
+            perror(reportPath);
+            return EXIT_FAILURE;
+        }
+    }
+    writeReport(report, rows, seconds);
+    if (report != stdout) {
+        fclose(report);
+    }
+    free(candidates);
+    return EXIT_SUCCESS;
+}
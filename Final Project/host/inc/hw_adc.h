@@ -0,0 +1,20 @@
+/*
+ * hw_adc.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare hw_adc.h. Only the registers the
+ *      firmware hands to the uDMA controller as transfer sources are defined.
+ */
+
+#ifndef __HW_ADC_H__
+#define __HW_ADC_H__
+
+//*****************************************************************************
+// ADC register offsets
+//*****************************************************************************
+#define ADC_O_SSFIFO0           0x00000048
+#define ADC_O_SSFIFO1           0x00000068
+#define ADC_O_SSFIFO2           0x00000088
+#define ADC_O_SSFIFO3           0x000000A8
+
+#endif /* __HW_ADC_H__ */
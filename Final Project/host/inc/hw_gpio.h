@@ -0,0 +1,25 @@
+/*
+ * hw_gpio.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare hw_gpio.h. Only the registers the
+ *      firmware touches directly through HWREG are defined.
+ */
+
+#ifndef __HW_GPIO_H__
+#define __HW_GPIO_H__
+
+//*****************************************************************************
+// GPIO register offsets
+//*****************************************************************************
+#define GPIO_O_DATA             0x00000000
+#define GPIO_O_DIR              0x00000400
+#define GPIO_O_LOCK             0x00000520
+#define GPIO_O_CR               0x00000524
+
+#define GPIO_LOCK_M             0xFFFFFFFF
+#define GPIO_LOCK_UNLOCKED      0x00000000
+#define GPIO_LOCK_LOCKED        0x00000001
+#define GPIO_LOCK_KEY           0x4C4F434B
+
+#endif /* __HW_GPIO_H__ */
@@ -0,0 +1,39 @@
+/*
+ * hw_memmap.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare hw_memmap.h. Base addresses match
+ *      the TM4C123GH6PM so that firmware constants keep their target values.
+ */
+
+#ifndef __HW_MEMMAP_H__
+#define __HW_MEMMAP_H__
+
+//*****************************************************************************
+// Peripheral base addresses
+//*****************************************************************************
+#define GPIO_PORTA_BASE         0x40004000
+#define GPIO_PORTB_BASE         0x40005000
+#define GPIO_PORTC_BASE         0x40006000
+#define GPIO_PORTD_BASE         0x40007000
+#define SSI3_BASE               0x4000B000
+#define UART0_BASE              0x4000C000
+#define GPIO_PORTE_BASE         0x40024000
+#define GPIO_PORTF_BASE         0x40025000
+#define PWM0_BASE               0x40028000
+#define PWM1_BASE               0x40029000
+#define TIMER0_BASE             0x40030000
+#define TIMER1_BASE             0x40031000
+#define TIMER2_BASE             0x40032000
+#define TIMER3_BASE             0x40033000
+#define TIMER4_BASE             0x40034000
+#define TIMER5_BASE             0x40035000
+#define WTIMER0_BASE            0x40036000
+#define WTIMER1_BASE            0x40037000
+#define ADC0_BASE               0x40038000
+#define ADC1_BASE               0x40039000
+#define SYSCTL_BASE             0x400FE000
+#define UDMA_BASE               0x400FF000
+#define NVIC_BASE               0xE000E000
+
+#endif /* __HW_MEMMAP_H__ */
@@ -0,0 +1,19 @@
+/*
+ * hw_timer.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare hw_timer.h. Only the registers the
+ *      firmware touches directly through HWREG are defined.
+ */
+
+#ifndef __HW_TIMER_H__
+#define __HW_TIMER_H__
+
+//*****************************************************************************
+// Timer register offsets
+//*****************************************************************************
+#define TIMER_O_CFG             0x00000000
+#define TIMER_O_TAILR           0x00000028
+#define TIMER_O_TAV             0x00000050
+
+#endif /* __HW_TIMER_H__ */
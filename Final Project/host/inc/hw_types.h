@@ -0,0 +1,24 @@
+/*
+ * hw_types.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare hw_types.h. Direct register access
+ *      through HWREG is routed to the simulator's register shadow instead of the
+ *      Cortex-M4 memory map.
+ */
+
+#ifndef __HW_TYPES_H__
+#define __HW_TYPES_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sim/simCore.h"
+
+//*****************************************************************************
+// Register access macros
+//*****************************************************************************
+#define HWREG(x)    (*simRegister((uint32_t)(x)))
+#define HWREGH(x)   (*(volatile uint16_t *)simRegister((uint32_t)(x)))
+#define HWREGB(x)   (*(volatile uint8_t *)simRegister((uint32_t)(x)))
+
+#endif /* __HW_TYPES_H__ */
@@ -0,0 +1,21 @@
+/*
+ * tm4c123gh6pm.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TM4C123GH6PM register definitions. Only the
+ *      registers used by buttons4.c to unlock PF0 are provided.
+ */
+
+#ifndef __TM4C123GH6PM_H__
+#define __TM4C123GH6PM_H__
+
+#include "inc/hw_types.h"
+#include "inc/hw_gpio.h"
+
+//*****************************************************************************
+// GPIO port F lock registers
+//*****************************************************************************
+#define GPIO_PORTF_LOCK_R       HWREG(0x40025520)
+#define GPIO_PORTF_CR_R         HWREG(0x40025524)
+
+#endif /* __TM4C123GH6PM_H__ */
@@ -0,0 +1,12 @@
+/*
+ * simAdcMode.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Altitude acquisition mode for the host build. Built without the
+ *      mode override, so altitude.h supplies the firmware's default.
+ */
+
+#include "altitude.h"
+#include "sim/simAdcMode.h"
+
+uint32_t simAdcMode = ADC_MODE;
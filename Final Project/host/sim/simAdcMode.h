@@ -0,0 +1,24 @@
+/*
+ * simAdcMode.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Altitude acquisition mode for the host build. The host Makefile
+ *      compiles altitude.c with ADC_MODE mapped onto simAdcMode, so a host tool can fly
+ *      the unmodified firmware with either the timer triggered burst or the uDMA capture.
+ */
+
+#ifndef SIMADCMODE_H_
+#define SIMADCMODE_H_
+
+//*****************************************************************************
+// Header files
+//*****************************************************************************
+#include <stdint.h>
+
+//*****************************************************************************
+// Mode the firmware samples the altitude in, ADC_MODE_BURST or ADC_MODE_DMA from
+// altitude.h. The firmware's own unless a host tool changes it before the run starts.
+//*****************************************************************************
+extern uint32_t simAdcMode;
+
+#endif /* SIMADCMODE_H_ */
@@ -0,0 +1,398 @@
+/*
+ * simCore.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Virtual Cortex-M4 core for the host build. Keeps a cycle accurate
+ *      virtual clock, a table of timed events and a priority based NVIC model so that the
+ *      firmware interrupt handlers run at the same points they would on the Tiva board.
+ */
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim/simCore.h"
+
+//*****************************************************************************
+// Structs
+//*****************************************************************************
+typedef struct {
+    simEventFn_t fn;
+    uint64_t when;
+    double seconds;                     // Virtual time, for events pinned to it
+    bool pinned;
+    bool scheduled;
+} simEvent_t;
+
+typedef struct {
+    uint32_t address;
+    volatile uint32_t value;
+} simRegister_t;
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static uint64_t cycles;                 // Virtual clock, in system clock cycles
+static uint32_t clockHz = SIM_DEFAULT_CLOCK_HZ;
+static uint64_t rebaseCycles;           // Cycle count when the clock was last changed
+static double rebaseSeconds;            // Virtual time when the clock was last changed
+
+static simEvent_t events[SIM_MAX_EVENTS];
+static int numEvents;
+static uint64_t nextEventTime = UINT64_MAX;
+static uint64_t eventFirings;
+
+static void (*handlers[SIM_NUM_INTERRUPTS])(void);
+static bool intPending[SIM_NUM_INTERRUPTS];
+static bool intEnabled[SIM_NUM_INTERRUPTS];
+static uint8_t intPriority[SIM_NUM_INTERRUPTS];
+static uint32_t numPending;
+static bool masterEnabled = true;
+static uint32_t activePriority = SIM_THREAD_PRIORITY;
+static uint32_t activeInterrupt;
+
+static simRegister_t registers[SIM_MAX_REGISTERS];
+static int numRegisters;
+
+static jmp_buf stopJump;
+static int stopEvent = -1;
+
+//*****************************************************************************
+// Recomputes the earliest scheduled event after the table changes
+//*****************************************************************************
+static void
+updateNextEvent(void)
+{
+    int i;
+    nextEventTime = UINT64_MAX;
+    for (i = 0; i < numEvents; i++) {
+        if (events[i].scheduled && events[i].when < nextEventTime) {
+            nextEventTime = events[i].when;
+        }
+    }
+}
+
+//*****************************************************************************
+// Fires the earliest scheduled event, advancing the clock to its time
+//*****************************************************************************
+static void
+fireNextEvent(void)
+{
+    int i;
+    int earliest = -1;
+    for (i = 0; i < numEvents; i++) {
+        if (events[i].scheduled && events[i].when == nextEventTime) {
+            earliest = i;
+            break;
+        }
+    }
+    if (earliest < 0) {
+        return;
+    }
+    if (cycles < events[earliest].when) {
+        cycles = events[earliest].when;
+    }
+    events[earliest].scheduled = false;
+    updateNextEvent();
+    eventFirings++;
+    events[earliest].fn();
+}
+
+//*****************************************************************************
+// Takes every pending interrupt that can preempt the running code, most urgent
+// first. Equal priorities are taken in exception number order, as on the NVIC.
+//*****************************************************************************
+static void
+serviceInterrupts(void)
+{
+    while (numPending > 0 && masterEnabled) {
+        uint32_t i;
+        uint32_t best = 0;
+        uint32_t bestPriority = activePriority;
+        for (i = 0; i < SIM_NUM_INTERRUPTS; i++) {
+            if (intPending[i] && intEnabled[i] && intPriority[i] < bestPriority) {
+                best = i;
+                bestPriority = intPriority[i];
+            }
+        }
+        if (best == 0 || handlers[best] == NULL) {
+            return;
+        }
+        uint32_t savedPriority = activePriority;
+        uint32_t savedInterrupt = activeInterrupt;
+        intPending[best] = false;
+        numPending--;
+        activePriority = bestPriority;
+        activeInterrupt = best;
+        simConsume(SIM_ISR_CYCLES);
+        handlers[best]();
+        simConsume(SIM_ISR_CYCLES);
+        activePriority = savedPriority;
+        activeInterrupt = savedInterrupt;
+    }
+}
+
+//*****************************************************************************
+// @return bool True if an enabled interrupt is pending that would preempt the
+// running code. This wakes a WFI even while interrupts are masked.
+//*****************************************************************************
+static bool
+hasWakeup(void)
+{
+    uint32_t i;
+    if (numPending == 0) {
+        return false;
+    }
+    for (i = 0; i < SIM_NUM_INTERRUPTS; i++) {
+        if (intPending[i] && intEnabled[i] && intPriority[i] < activePriority
+                && handlers[i] != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//*****************************************************************************
+// Stops the run once the requested virtual time has passed
+//*****************************************************************************
+static void
+stopTimeHandler(void)
+{
+    simStop(SIM_STOP_TIME);
+}
+
+uint64_t
+simCycles(void)
+{
+    return cycles;
+}
+
+uint32_t
+simClockHz(void)
+{
+    return clockHz;
+}
+
+void
+simSetClockHz(uint32_t hz)
+{
+    int i;
+    rebaseSeconds = simSeconds();
+    rebaseCycles = cycles;
+    clockHz = hz;
+    // Keep events pinned to virtual time at the same time under the new clock
+    for (i = 0; i < numEvents; i++) {
+        if (events[i].scheduled && events[i].pinned) {
+            events[i].when = simSecondsToCycles(events[i].seconds);
+        }
+    }
+    updateNextEvent();
+}
+
+uint64_t
+simSecondsToCycles(double seconds)
+{
+    return rebaseCycles + (uint64_t)((seconds - rebaseSeconds) * clockHz);
+}
+
+double
+simSeconds(void)
+{
+    return rebaseSeconds + (double)(cycles - rebaseCycles) / clockHz;
+}
+
+void
+simConsume(uint32_t work)
+{
+    simConsumeUntil(cycles + work);
+}
+
+void
+simConsumeUntil(uint64_t when)
+{
+    while (nextEventTime <= when) {
+        fireNextEvent();
+        serviceInterrupts();
+    }
+    if (cycles < when) {
+        cycles = when;
+    }
+    if (numPending > 0) {
+        serviceInterrupts();
+    }
+}
+
+void
+simWaitForInterrupt(void)
+{
+    // Skip the idle cycles event by event until something wakes the core
+    while (!hasWakeup()) {
+        if (nextEventTime == UINT64_MAX) {
+            simStop(SIM_STOP_HALT);
+        }
+        fireNextEvent();
+    }
+    serviceInterrupts();
+}
+
+int
+simEventRegister(simEventFn_t fn)
+{
+    if (numEvents >= SIM_MAX_EVENTS) {
+        return -1;
+    }
+    events[numEvents].fn = fn;
+    events[numEvents].scheduled = false;
+    return numEvents++;
+}
+
+void
+simEventAt(int id, uint64_t when)
+{
+    events[id].when = when;
+    events[id].pinned = false;
+    events[id].scheduled = true;
+    if (when < nextEventTime) {
+        nextEventTime = when;
+    } else {
+        updateNextEvent();
+    }
+}
+
+void
+simEventAtSeconds(int id, double seconds)
+{
+    simEventAt(id, simSecondsToCycles(seconds));
+    events[id].seconds = seconds;
+    events[id].pinned = true;
+}
+
+uint64_t
+simEventFirings(void)
+{
+    return eventFirings;
+}
+
+void
+simEventCancel(int id)
+{
+    events[id].scheduled = false;
+    updateNextEvent();
+}
+
+void
+simIntRegister(uint32_t intNum, void (*handler)(void))
+{
+    handlers[intNum] = handler;
+}
+
+void
+simIntEnable(uint32_t intNum, bool enable)
+{
+    intEnabled[intNum] = enable;
+    // One left pending while it was disabled is taken as soon as it is enabled again
+    if (enable) {
+        serviceInterrupts();
+    }
+}
+
+bool
+simIntIsEnabled(uint32_t intNum)
+{
+    return intEnabled[intNum];
+}
+
+void
+simIntPrioritySet(uint32_t intNum, uint8_t priority)
+{
+    intPriority[intNum] = priority;
+}
+
+uint8_t
+simIntPriorityGet(uint32_t intNum)
+{
+    return intPriority[intNum];
+}
+
+void
+simIntPend(uint32_t intNum)
+{
+    if (!intPending[intNum]) {
+        intPending[intNum] = true;
+        numPending++;
+    }
+}
+
+void
+simIntUnpend(uint32_t intNum)
+{
+    if (intPending[intNum]) {
+        intPending[intNum] = false;
+        numPending--;
+    }
+}
+
+bool
+simIntMasterSet(bool enable)
+{
+    bool wasDisabled = !masterEnabled;
+    masterEnabled = enable;
+    if (enable) {
+        serviceInterrupts();
+    }
+    return wasDisabled;
+}
+
+uint32_t
+simActiveInterrupt(void)
+{
+    return activeInterrupt;
+}
+
+volatile uint32_t *
+simRegister(uint32_t address)
+{
+    int i;
+    for (i = 0; i < numRegisters; i++) {
+        if (registers[i].address == address) {
+            if (address == SIM_DWT_CYCCNT) {
+                registers[i].value = (uint32_t)cycles;
+            }
+            return &registers[i].value;
+        }
+    }
+    if (numRegisters >= SIM_MAX_REGISTERS) {
+        // Sharing a register would alias two peripherals and make every result wrong
+        fprintf(stderr, "simRegister: no shadow register left for 0x%08x, raise "
+                "SIM_MAX_REGISTERS (%d)\n", address, SIM_MAX_REGISTERS);
+        abort();
+    }
+    registers[numRegisters].address = address;
+    registers[numRegisters].value = address == SIM_DWT_CYCCNT ? (uint32_t)cycles : 0;
+    return &registers[numRegisters++].value;
+}
+
+int
+simRun(int (*entry)(void), double seconds)
+{
+    int reason;
+    if (stopEvent < 0) {
+        stopEvent = simEventRegister(stopTimeHandler);
+    }
+    simEventAtSeconds(stopEvent, seconds);
+    reason = setjmp(stopJump);
+    if (reason == 0) {
+        entry();
+        reason = SIM_STOP_HALT;
+    }
+    // Unwound out of whatever handler was running
+    activePriority = SIM_THREAD_PRIORITY;
+    activeInterrupt = 0;
+    return reason;
+}
+
+void
+simStop(int reason)
+{
+    longjmp(stopJump, reason);
+}
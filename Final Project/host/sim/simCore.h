@@ -0,0 +1,235 @@
+/*
+ * simCore.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Virtual Cortex-M4 core for the host build. Keeps a cycle accurate
+ *      virtual clock, a table of timed events and a priority based NVIC model so that the
+ *      firmware interrupt handlers run at the same points they would on the Tiva board.
+ *      Time only moves when the firmware calls into driverlib or waits for an interrupt,
+ *      so a run costs as much host time as the firmware work in it, not the wall clock.
+ */
+
+#ifndef SIMCORE_H_
+#define SIMCORE_H_
+
+//*****************************************************************************
+// Header files
+//*****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define SIM_CALL_CYCLES 20          // Cycles charged for every driverlib call
+#define SIM_ISR_CYCLES 12           // Exception entry latency of the Cortex-M4
+#define SIM_NUM_INTERRUPTS 155      // Matches NUM_INTERRUPTS in inc/hw_ints.h
+#define SIM_MAX_EVENTS 16
+#define SIM_MAX_REGISTERS 64
+#define SIM_THREAD_PRIORITY 0x100   // Priority of code running outside any handler
+#define SIM_DEFAULT_CLOCK_HZ 16000000
+#define SIM_DWT_CYCCNT 0xE0001004   // Cycle counter, reads back the virtual clock
+
+//*****************************************************************************
+// Reasons a simulated run stops
+//*****************************************************************************
+enum simStopReasons {SIM_STOP_TIME = 1, SIM_STOP_RESET, SIM_STOP_HALT};
+
+typedef void (*simEventFn_t)(void);
+
+//*****************************************************************************
+// @return uint64_t Number of cycles executed since the start of the run
+//*****************************************************************************
+uint64_t
+simCycles(void);
+
+//*****************************************************************************
+// @return uint32_t The current system clock frequency in Hz
+//*****************************************************************************
+uint32_t
+simClockHz(void);
+
+//*****************************************************************************
+// @param hz The new system clock frequency, set by SysCtlClockSet()
+//*****************************************************************************
+void
+simSetClockHz(uint32_t hz);
+
+//*****************************************************************************
+// @param cycles Number of cycles the firmware spends doing work
+//
+// Advances the virtual clock, firing any timed events that fall inside the
+// interval and taking any interrupts that become pending.
+//*****************************************************************************
+void
+simConsume(uint32_t cycles);
+
+//*****************************************************************************
+// @param when Absolute cycle count to advance to
+//
+// Advances the virtual clock up to an absolute time, used by blocking driverlib
+// calls that would otherwise poll a status flag.
+//*****************************************************************************
+void
+simConsumeUntil(uint64_t when);
+
+//*****************************************************************************
+// Sleeps until the next interrupt is taken, jumping the clock straight to the
+// next timed event rather than spinning through the idle cycles.
+//*****************************************************************************
+void
+simWaitForInterrupt(void);
+
+//*****************************************************************************
+// @param fn Function to call when the event fires
+//
+// @return int The id used to schedule the event, or -1 if the table is full
+//*****************************************************************************
+int
+simEventRegister(simEventFn_t fn);
+
+//*****************************************************************************
+// @param id The event returned by simEventRegister()
+//
+// @param when Absolute cycle count the event fires at
+//*****************************************************************************
+void
+simEventAt(int id, uint64_t when);
+
+//*****************************************************************************
+// @param id The event returned by simEventRegister()
+//
+// @param seconds Virtual time the event fires at
+//
+// Unlike simEventAt() the event keeps its virtual time if the firmware changes
+// the system clock before it fires, as rig events scheduled before boot need.
+//*****************************************************************************
+void
+simEventAtSeconds(int id, double seconds);
+
+//*****************************************************************************
+// @return uint64_t Number of timed events fired so far, so observers can tell
+// which changes a single event made together
+//*****************************************************************************
+uint64_t
+simEventFirings(void);
+
+//*****************************************************************************
+// @param id The event returned by simEventRegister()
+//
+// Removes the event from the timeline without unregistering it
+//*****************************************************************************
+void
+simEventCancel(int id);
+
+//*****************************************************************************
+// @param intNum Exception number, as defined in inc/hw_ints.h
+//
+// @param handler The handler run when the interrupt is taken
+//*****************************************************************************
+void
+simIntRegister(uint32_t intNum, void (*handler)(void));
+
+//*****************************************************************************
+// @param intNum Exception number to enable or disable in the NVIC
+//*****************************************************************************
+void
+simIntEnable(uint32_t intNum, bool enable);
+
+//*****************************************************************************
+// @param intNum Exception number
+//
+// @return bool True if the exception is enabled in the NVIC
+//*****************************************************************************
+bool
+simIntIsEnabled(uint32_t intNum);
+
+//*****************************************************************************
+// @param intNum Exception number
+//
+// @param priority Priority in the upper three bits, lower value is more urgent
+//*****************************************************************************
+void
+simIntPrioritySet(uint32_t intNum, uint8_t priority);
+
+//*****************************************************************************
+// @param intNum Exception number
+//
+// @return uint8_t The priority of the exception
+//*****************************************************************************
+uint8_t
+simIntPriorityGet(uint32_t intNum);
+
+//*****************************************************************************
+// @param intNum Exception number to mark as pending
+//*****************************************************************************
+void
+simIntPend(uint32_t intNum);
+
+//*****************************************************************************
+// @param intNum Exception number to clear from the pending set
+//*****************************************************************************
+void
+simIntUnpend(uint32_t intNum);
+
+//*****************************************************************************
+// @param enable True to enable interrupts at the processor level
+//
+// @return bool True if interrupts were disabled before the call
+//*****************************************************************************
+bool
+simIntMasterSet(bool enable);
+
+//*****************************************************************************
+// @return uint32_t Exception number of the running handler, 0 in thread mode
+//*****************************************************************************
+uint32_t
+simActiveInterrupt(void);
+
+//*****************************************************************************
+// @param address Register address used through HWREG
+//
+// @return volatile uint32_t* Shadow storage for the register. The DWT cycle
+// counter is refreshed from the virtual clock on every access, so writes to it
+// are lost. Aborts, naming the address, if SIM_MAX_REGISTERS other addresses
+// already have one.
+//*****************************************************************************
+volatile uint32_t *
+simRegister(uint32_t address);
+
+//*****************************************************************************
+// @param entry The firmware entry point
+//
+// @param seconds Virtual time to run for
+//
+// @return int The stop reason from simStopReasons
+//
+// Runs the firmware until the virtual time expires, the firmware asks for a
+// reset or the processor has nothing left to wait for.
+//*****************************************************************************
+int
+simRun(int (*entry)(void), double seconds);
+
+//*****************************************************************************
+// @param reason The stop reason from simStopReasons
+//
+// Ends the current run, unwinding back to simRun()
+//*****************************************************************************
+void
+simStop(int reason);
+
+//*****************************************************************************
+// @param seconds Virtual time in seconds
+//
+// @return uint64_t The equivalent number of cycles at the current clock
+//*****************************************************************************
+uint64_t
+simSecondsToCycles(double seconds);
+
+//*****************************************************************************
+// @return double The virtual time since the start of the run, in seconds
+//*****************************************************************************
+double
+simSeconds(void);
+
+#endif /* SIMCORE_H_ */
@@ -0,0 +1,14 @@
+/*
+ * simGains.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Controller gains for the host build. Built without the gain
+ *      overrides, so pidController.h supplies the firmware's values.
+ */
+
+#include "pidController.h"
+#include "sim/simGains.h"
+
+const simGains_t simFirmwareGains = {KP_ALTITUDE, KI_ALTITUDE, KP_YAW, KI_YAW, KD_YAW};
+
+simGains_t simGains = {KP_ALTITUDE, KI_ALTITUDE, KP_YAW, KI_YAW, KD_YAW};
@@ -0,0 +1,40 @@
+/*
+ * simGains.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Controller gains for the host build. The host Makefile compiles
+ *      pidController.c with the KP_/KI_/KD_ constants mapped onto simGains, so a host
+ *      tool can fly the unmodified controllers with any set of gains.
+ */
+
+#ifndef SIMGAINS_H_
+#define SIMGAINS_H_
+
+//*****************************************************************************
+// Header files
+//*****************************************************************************
+#include <stdint.h>
+
+//*****************************************************************************
+// Structs
+//*****************************************************************************
+typedef struct {
+    int32_t kpAltitude;
+    int32_t kiAltitude;
+    int32_t kpYaw;
+    int32_t kiYaw;
+    int32_t kdYaw;
+} simGains_t;
+
+//*****************************************************************************
+// Gains the firmware ships with, from pidController.h
+//*****************************************************************************
+extern const simGains_t simFirmwareGains;
+
+//*****************************************************************************
+// Gains the controllers use, the firmware's unless a host tool changes them
+// before the run starts
+//*****************************************************************************
+extern simGains_t simGains;
+
+#endif /* SIMGAINS_H_ */
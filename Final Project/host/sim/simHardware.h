@@ -0,0 +1,104 @@
+/*
+ * simHardware.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Rig side of the simulated peripherals. The firmware talks to the
+ *      driverlib stand-ins; the simulated rig and the host tools use these functions to
+ *      drive inputs into them and observe their outputs.
+ */
+
+#ifndef SIMHARDWARE_H_
+#define SIMHARDWARE_H_
+
+//*****************************************************************************
+// Header files
+//*****************************************************************************
+#include <stdint.h>
+#include <stdio.h>
+
+//*****************************************************************************
+// @param base GPIO port base address
+//
+// @param pins Pins the rig drives
+//
+// @param levels Levels to drive the pins to, raising edge interrupts as needed
+//*****************************************************************************
+void
+simGpioDrive(uint32_t base, uint8_t pins, uint8_t levels);
+
+//*****************************************************************************
+// @param base GPIO port base address
+//
+// @param pins Pins the rig stops driving, leaving them to their pad pulls
+//*****************************************************************************
+void
+simGpioRelease(uint32_t base, uint8_t pins);
+
+//*****************************************************************************
+// @param base GPIO port base address
+//
+// @return uint8_t The level of every pin on the port
+//*****************************************************************************
+uint8_t
+simGpioLevels(uint32_t base);
+
+//*****************************************************************************
+// @param channel Analog input channel, as in ADC_CTL_CHn
+//
+// @param volts Voltage presented to the channel
+//*****************************************************************************
+void
+simAdcSetVoltage(uint32_t channel, double volts);
+
+//*****************************************************************************
+// @param channel Analog input channel, as in ADC_CTL_CHn
+//
+// @param code Presents the voltage at the middle of this 12-bit code, which converts
+// to it give or take the converter noise
+//*****************************************************************************
+void
+simAdcSetCode(uint32_t channel, uint32_t code);
+
+//*****************************************************************************
+// @param channel Analog input channel, as in ADC_CTL_CHn
+//
+// @return double Voltage presented to the channel
+//*****************************************************************************
+double
+simAdcGetVoltage(uint32_t channel);
+
+//*****************************************************************************
+// @param base PWM module base address
+//
+// @param out PWM output, as in PWM_OUT_n
+//
+// @return double The duty cycle seen on the pin in percent, 0 when disabled
+//*****************************************************************************
+double
+simPwmDuty(uint32_t base, uint32_t out);
+
+//*****************************************************************************
+// @return uint32_t The divider between the system clock and the PWM clock
+//*****************************************************************************
+uint32_t
+simPwmClockDivider(void);
+
+//*****************************************************************************
+// @param output Stream transmitted UART characters are copied to, NULL to drop them
+//*****************************************************************************
+void
+simUartSetOutput(FILE *output);
+
+//*****************************************************************************
+// @param data Characters to place in the UART receive buffer
+//*****************************************************************************
+void
+simUartReceive(const char *data);
+
+//*****************************************************************************
+// @return uint64_t Number of frames sent over SSI to the OLED
+//*****************************************************************************
+uint64_t
+simSsiFramesSent(void);
+
+#endif /* SIMHARDWARE_H_ */
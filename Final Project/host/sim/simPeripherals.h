@@ -0,0 +1,46 @@
+/*
+ * simPeripherals.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Signals between the simulated peripherals, for the links the Tiva
+ *      makes in hardware: a timer triggering the ADC, and a peripheral requesting a
+ *      uDMA transfer. Only the driverlib stand-ins call these.
+ */
+
+#ifndef SIMPERIPHERALS_H_
+#define SIMPERIPHERALS_H_
+
+//*****************************************************************************
+// Header files
+//*****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+//*****************************************************************************
+// Outcome of a uDMA request
+//*****************************************************************************
+typedef enum {
+    SIM_UDMA_REFUSED = 0,   // Channel not ready, the item stays with the peripheral
+    SIM_UDMA_MOVED,         // Item moved
+    SIM_UDMA_DONE           // Item moved and it finished a transfer
+} simUdmaResult_t;
+
+//*****************************************************************************
+// A timer with its ADC trigger output enabled timed out, starting every
+// enabled ADC sequence configured with ADC_TRIGGER_TIMER
+//*****************************************************************************
+void
+simAdcTimerTrigger(void);
+
+//*****************************************************************************
+// @param channel uDMA channel making the request
+//
+// @param value Item the peripheral offers, written at the transfer's item size
+//
+// @return simUdmaResult_t Whether the item was taken and whether that finished the
+// transfer, which the peripheral signals on its own interrupt
+//*****************************************************************************
+simUdmaResult_t
+simUdmaRequest(uint32_t channel, uint32_t value);
+
+#endif /* SIMPERIPHERALS_H_ */
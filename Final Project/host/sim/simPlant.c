@@ -0,0 +1,216 @@
+/*
+ * simPlant.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Closed-loop model of the helicopter rig. Reads the main and tail
+ *      rotor duty cycles from the simulated PWM outputs, integrates the rig dynamics at
+ *      a fixed step and feeds the altitude voltage, quadrature edges and reference pulse
+ *      back to the simulated ADC and GPIO pins the firmware samples.
+ */
+
+#include <math.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/gpio.h"
+#include "driverlib/pwm.h"
+#include "sim/simCore.h"
+#include "sim/simHardware.h"
+#include "sim/simPlant.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+// Rig wiring: main rotor on M0PWM7 (PC5), tail rotor on M1PWM5 (PF1)
+#define MAIN_PWM_BASE PWM0_BASE
+#define MAIN_PWM_OUT PWM_OUT_7
+#define TAIL_PWM_BASE PWM1_BASE
+#define TAIL_PWM_OUT PWM_OUT_5
+// Quadrature channels A and B on PB0/PB1, active low reference on PC4
+#define ENCODER_BASE GPIO_PORTB_BASE
+#define ENCODER_PINS (GPIO_PIN_0 | GPIO_PIN_1)
+#define REFERENCE_BASE GPIO_PORTC_BASE
+#define REFERENCE_PIN GPIO_PIN_4
+
+#define MAX_ALTITUDE 100.0
+#define DEGREES 360.0
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static simPlantParams_t plant;
+static simPlantState_t state;
+static double heading;              // Unwrapped heading in degrees
+static int64_t encoderCount;        // Transitions already presented on the encoder pins
+static int64_t encoderTarget;       // Transitions the heading calls for
+static uint64_t encoderSpacing;     // Cycles between edges when catching up
+static uint64_t steps;
+static uint32_t noiseState;
+static int stepEvent = -1;
+static int encoderEvent = -1;
+
+// Channel levels (A in bit 0, B in bit 1) for each count modulo 4, in the order
+// quadratureHandler() counts as increasing yaw
+static const uint8_t quadraturePhase[4] = {0x0, 0x2, 0x3, 0x1};
+
+//*****************************************************************************
+// @return double Uniform noise in [-1, 1] from a xorshift generator
+//*****************************************************************************
+static double
+noise(void)
+{
+    noiseState ^= noiseState << 13;
+    noiseState ^= noiseState >> 17;
+    noiseState ^= noiseState << 5;
+    return (double)noiseState / UINT32_MAX * 2.0 - 1.0;
+}
+
+//*****************************************************************************
+// Drives the encoder and reference pins for the current count
+//*****************************************************************************
+static void
+presentEncoder(void)
+{
+    int64_t slot = ((encoderCount % PLANT_SLOTS) + PLANT_SLOTS) % PLANT_SLOTS;
+    simGpioDrive(ENCODER_BASE, ENCODER_PINS, quadraturePhase[encoderCount & 3]);
+    simGpioDrive(REFERENCE_BASE, REFERENCE_PIN, slot == 0 ? 0 : REFERENCE_PIN);
+}
+
+//*****************************************************************************
+// Emits one quadrature transition toward the heading. Edges are spread over the
+// step so the firmware sees each one, as the real encoder would produce them.
+//*****************************************************************************
+static void
+encoderHandler(void)
+{
+    if (encoderCount < encoderTarget) {
+        encoderCount++;
+    } else if (encoderCount > encoderTarget) {
+        encoderCount--;
+    }
+    presentEncoder();
+    if (encoderCount != encoderTarget) {
+        simEventAt(encoderEvent, simCycles() + encoderSpacing);
+    }
+}
+
+//*****************************************************************************
+// Steps the rig and schedules the next step on the fixed integration grid
+//*****************************************************************************
+static void
+stepHandler(void)
+{
+    simPlantStep(1.0 / PLANT_STEP_HZ);
+    steps++;
+    simEventAtSeconds(stepEvent, (double)steps / PLANT_STEP_HZ);
+}
+
+void
+simPlantDefaultParams(simPlantParams_t *params)
+{
+    params->mainTau = 0.25;
+    params->tailTau = 0.15;
+    params->hoverDuty = 35.0;
+    params->gravity = 30.0;
+    params->verticalDrag = 6.0;
+    params->yawGain = 0.03;
+    params->coupling = 0.8;
+    params->yawDrag = 3.0;
+    params->yawFriction = 20.0;
+    params->groundFriction = 400.0;
+    // The firmware converts 10 mV of sensor drop to 1% altitude
+    params->groundVoltage = 2.5;
+    params->rangeVoltage = 1.0;
+    params->noiseVoltage = 0.005;
+    params->startYaw = 40.0;
+    params->seed = 1;
+}
+
+void
+simPlantInit(const simPlantParams_t *params)
+{
+    plant = *params;
+    state = (simPlantState_t){0};
+    heading = plant.startYaw;
+    encoderCount = (int64_t)floor(heading * PLANT_SLOTS / DEGREES);
+    encoderTarget = encoderCount;
+    noiseState = plant.seed ? plant.seed : 1;
+    steps = 0;
+    presentEncoder();
+    simAdcSetVoltage(PLANT_ALTITUDE_CHANNEL, plant.groundVoltage);
+    if (stepEvent < 0) {
+        stepEvent = simEventRegister(stepHandler);
+        encoderEvent = simEventRegister(encoderHandler);
+    }
+    simEventAtSeconds(stepEvent, 0);
+}
+
+simPlantState_t
+simPlantState(void)
+{
+    return state;
+}
+
+void
+simPlantStep(double dt)
+{
+    double lift;
+    double torque;
+    double friction;
+    int64_t change;
+
+    // Motor speeds lag the commanded duty
+    state.mainDuty = simPwmDuty(MAIN_PWM_BASE, MAIN_PWM_OUT);
+    state.tailDuty = simPwmDuty(TAIL_PWM_BASE, TAIL_PWM_OUT);
+    state.mainSpeed += (state.mainDuty - state.mainSpeed) * dt / plant.mainTau;
+    state.tailSpeed += (state.tailDuty - state.tailSpeed) * dt / plant.tailTau;
+
+    // Thrust goes with the square of rotor speed and balances gravity at hover
+    lift = state.mainSpeed / plant.hoverDuty;
+    state.climbRate += (plant.gravity * (lift * lift - 1.0)
+                        - plant.verticalDrag * state.climbRate) * dt;
+    state.altitude += state.climbRate * dt;
+    if (state.altitude <= 0) {
+        state.altitude = 0;
+        if (state.climbRate < 0) {
+            state.climbRate = 0;
+        }
+    } else if (state.altitude >= MAX_ALTITUDE) {
+        state.altitude = MAX_ALTITUDE;
+        if (state.climbRate > 0) {
+            state.climbRate = 0;
+        }
+    }
+
+    // Tail thrust against the main rotor's reaction torque, with rig friction
+    torque = plant.yawGain * (state.tailSpeed * state.tailSpeed
+                              - plant.coupling * state.mainSpeed * state.mainSpeed)
+             - plant.yawDrag * state.yawRate;
+    friction = state.altitude > 0 ? plant.yawFriction : plant.groundFriction;
+    if (state.yawRate != 0 || fabs(torque) > friction) {
+        double direction = state.yawRate != 0 ? state.yawRate : torque;
+        double yawRate = state.yawRate + (torque - (direction > 0 ? friction : -friction)) * dt;
+        // Friction can stop the rig but never turn it around
+        if (yawRate * state.yawRate < 0 && fabs(torque) <= friction) {
+            yawRate = 0;
+        }
+        state.yawRate = yawRate;
+    }
+    heading += state.yawRate * dt;
+    state.yaw = fmod(heading, DEGREES);
+    if (state.yaw >= DEGREES / 2) {
+        state.yaw -= DEGREES;
+    } else if (state.yaw < -DEGREES / 2) {
+        state.yaw += DEGREES;
+    }
+
+    // Sensor outputs
+    simAdcSetVoltage(PLANT_ALTITUDE_CHANNEL, plant.groundVoltage
+                     - state.altitude / MAX_ALTITUDE * plant.rangeVoltage
+                     + plant.noiseVoltage * noise());
+    encoderTarget = (int64_t)floor(heading * PLANT_SLOTS / DEGREES);
+    change = encoderTarget > encoderCount ? encoderTarget - encoderCount
+                                          : encoderCount - encoderTarget;
+    if (change > 0 && encoderEvent >= 0) {
+        encoderSpacing = (uint64_t)(simClockHz() * dt / change);
+        simEventAt(encoderEvent, simCycles());
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * simPlant.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Closed-loop model of the helicopter rig. Reads the main and tail
+ *      rotor duty cycles from the simulated PWM outputs, integrates the rig dynamics at
+ *      a fixed step and feeds the altitude voltage, quadrature edges and reference pulse
+ *      back to the simulated ADC and GPIO pins the firmware samples.
+ */
+
+#ifndef SIMPLANT_H_
+#define SIMPLANT_H_
+
+//*****************************************************************************
+// Header files
+//*****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define PLANT_STEP_HZ 2000          // Integration rate, independent of SYSTICK_RATE_HZ
+#define PLANT_SLOTS 448             // Quadrature transitions per revolution
+#define PLANT_ALTITUDE_CHANNEL 9    // AIN9 on PE4
+
+//*****************************************************************************
+// Structs
+//*****************************************************************************
+typedef struct {
+    double mainTau;             // Main rotor speed time constant (s)
+    double tailTau;             // Tail rotor speed time constant (s)
+    double hoverDuty;           // Main duty that holds the helicopter still (%)
+    double gravity;             // Net downward acceleration with rotors off (%/s^2)
+    double verticalDrag;        // Vertical velocity damping (1/s)
+    double yawGain;             // Yaw acceleration per squared tail duty (deg/s^2/%^2)
+    double coupling;            // Main rotor reaction torque relative to the tail
+    double yawDrag;             // Yaw rate damping (1/s)
+    double yawFriction;         // Bearing friction while airborne (deg/s^2)
+    double groundFriction;      // Friction while resting on the ground (deg/s^2)
+    double groundVoltage;       // Altitude sensor output when landed (V)
+    double rangeVoltage;        // Drop in sensor output from landed to full height (V)
+    double noiseVoltage;        // Peak sensor noise (V)
+    double startYaw;            // Heading at power on, relative to the reference (deg)
+    uint32_t seed;              // Noise generator seed, so runs are repeatable
+} simPlantParams_t;
+
+typedef struct {
+    double altitude;            // Height as a percentage of the rig's travel
+    double climbRate;           // %/s
+    double yaw;                 // Heading relative to the reference, -180 to 180 deg
+    double yawRate;             // deg/s
+    double mainSpeed;           // Main rotor speed in equivalent duty (%)
+    double tailSpeed;           // Tail rotor speed in equivalent duty (%)
+    double mainDuty;            // Duty seen on the main rotor pin (%)
+    double tailDuty;            // Duty seen on the tail rotor pin (%)
+} simPlantState_t;
+
+//*****************************************************************************
+// @param params Filled with the parameters of the lab rig
+//*****************************************************************************
+void
+simPlantDefaultParams(simPlantParams_t *params);
+
+//*****************************************************************************
+// @param params Rig parameters for this run
+//
+// Puts the rig at rest on the ground and starts stepping it on the virtual clock
+//*****************************************************************************
+void
+simPlantInit(const simPlantParams_t *params);
+
+//*****************************************************************************
+// @return simPlantState_t The rig state after the last integration step
+//*****************************************************************************
+simPlantState_t
+simPlantState(void);
+
+//*****************************************************************************
+// @param dt Integration step in seconds
+//
+// Advances the rig by one step from the current PWM duty cycles. Exposed so the
+// model can be benchmarked and stepped without the firmware.
+//*****************************************************************************
+void
+simPlantStep(double dt);
+
+#endif /* SIMPLANT_H_ */
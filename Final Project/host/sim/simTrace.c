@@ -0,0 +1,233 @@
+/*
+ * simTrace.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Records the inputs the rig presents to the simulated board and
+ *      replays them into a later run. Inputs are timed in cycles of the virtual clock
+ *      and the firmware is deterministic on it, so a replayed input lands at the same
+ *      point in the firmware as it did when recorded and the run reproduces exactly.
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim/simCore.h"
+#include "sim/simHardware.h"
+#include "sim/simTrace.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define LINE_LEN 128
+#define NUM_CHANNELS 16
+#define FNV_OFFSET 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+//*****************************************************************************
+// Static variables
+//*****************************************************************************
+static FILE *recordFile;
+static uint64_t recordCycle = UINT64_MAX;   // Time of the last line recorded
+static uint64_t recordFiring;               // Event that recorded the last line
+static double recordVolts[NUM_CHANNELS];    // Last voltage recorded on each channel
+static bool recordedVolts[NUM_CHANNELS];
+
+static FILE *replayFile;
+static char replayLine[LINE_LEN];           // Next line to apply
+static uint64_t replayLineNum;
+static int replayEvent = -1;
+
+static FILE *outputFile;
+static uint64_t outputCount;
+static uint64_t outputHash = FNV_OFFSET;
+
+//*****************************************************************************
+// Starts a recorded line with its time, or '+' if the same event made the
+// change on the line before
+//*****************************************************************************
+static void
+recordTime(void)
+{
+    uint64_t now = simCycles();
+    uint64_t firing = simEventFirings();
+    if (now == recordCycle && firing == recordFiring) {
+        fputs("+ ", recordFile);
+    } else {
+        fprintf(recordFile, "%llu ", (unsigned long long)now);
+    }
+    recordCycle = now;
+    recordFiring = firing;
+}
+
+//*****************************************************************************
+// @param line Buffer for the next line of the replay trace
+//
+// @return bool False at the end of the file. Comments and blank lines are skipped.
+//*****************************************************************************
+static bool
+readLine(char *line)
+{
+    while (fgets(line, LINE_LEN, replayFile) != NULL) {
+        replayLineNum++;
+        if (line[0] != '#' && line[0] != '\n') {
+            return true;
+        }
+    }
+    return false;
+}
+
+//*****************************************************************************
+// @param line A trace line, time included
+//
+// Presents the input on the line to the simulated board
+//*****************************************************************************
+static void
+applyLine(const char *line)
+{
+    const char *rest = strchr(line, ' ');
+    char kind[16];
+    unsigned long a;
+    unsigned long b;
+    unsigned long c;
+    double volts;
+    int fields = rest != NULL ? sscanf(rest, "%15s %li %li %li", kind, &a, &b, &c) : 0;
+
+    // A voltage is a hex float, which the integer fields stop part way through
+    if (fields >= 2 && strcmp(kind, "volts") == 0) {
+        fields = sscanf(rest, "%15s %li %lf", kind, &a, &volts);
+    }
+    if (fields == 4 && strcmp(kind, "gpio") == 0) {
+        simGpioDrive(a, b, c);
+    } else if (fields == 3 && strcmp(kind, "release") == 0) {
+        simGpioRelease(a, b);
+    } else if (fields == 3 && strcmp(kind, "volts") == 0) {
+        simAdcSetVoltage(a, volts);
+    } else if (fields == 3 && strcmp(kind, "adc") == 0) {
+        simAdcSetCode(a, b);
+    } else if (fields == 1 && strcmp(kind, "end") == 0) {
+        simStop(SIM_STOP_TIME);
+    } else {
+        fprintf(stderr, "trace line %llu not understood: %s",
+                (unsigned long long)replayLineNum, line);
+        simStop(SIM_STOP_HALT);
+    }
+}
+
+//*****************************************************************************
+// Applies the next group of lines and schedules the one after
+//*****************************************************************************
+static void
+replayHandler(void)
+{
+    applyLine(replayLine);
+    while (readLine(replayLine)) {
+        if (replayLine[0] != '+') {
+            simEventAt(replayEvent, strtoull(replayLine, NULL, 10));
+            return;
+        }
+        applyLine(replayLine);
+    }
+    // Recording cut short without its end line
+    simStop(SIM_STOP_TIME);
+}
+
+void
+simTraceRecord(FILE *inputs)
+{
+    int i;
+    recordFile = inputs;
+    for (i = 0; i < NUM_CHANNELS; i++) {
+        recordedVolts[i] = false;
+    }
+    fputs("# heliSim input trace, times in system clock cycles\n", recordFile);
+}
+
+void
+simTraceReplay(FILE *inputs)
+{
+    replayFile = inputs;
+    replayLineNum = 0;
+    if (replayEvent < 0) {
+        replayEvent = simEventRegister(replayHandler);
+    }
+    if (readLine(replayLine)) {
+        simEventAt(replayEvent, strtoull(replayLine, NULL, 10));
+    }
+}
+
+void
+simTraceFinish(void)
+{
+    if (recordFile != NULL) {
+        fprintf(recordFile, "%llu end\n", (unsigned long long)simCycles());
+        recordFile = NULL;
+    }
+}
+
+void
+simTraceOutputs(FILE *outputs)
+{
+    outputFile = outputs;
+}
+
+uint64_t
+simTraceOutputCount(void)
+{
+    return outputCount;
+}
+
+uint64_t
+simTraceOutputHash(void)
+{
+    return outputHash;
+}
+
+void
+simTraceGpio(uint32_t base, uint8_t pins, uint8_t levels, bool drive)
+{
+    if (recordFile == NULL) {
+        return;
+    }
+    recordTime();
+    if (drive) {
+        fprintf(recordFile, "gpio 0x%08x 0x%02x 0x%02x\n", base, pins, levels & pins);
+    } else {
+        fprintf(recordFile, "release 0x%08x 0x%02x\n", base, pins);
+    }
+}
+
+void
+simTraceAdc(uint32_t channel, double volts)
+{
+    // Only the voltages the firmware converts matter, and only when they change
+    channel %= NUM_CHANNELS;
+    if (recordFile == NULL || (recordedVolts[channel] && recordVolts[channel] == volts)) {
+        return;
+    }
+    recordVolts[channel] = volts;
+    recordedVolts[channel] = true;
+    recordTime();
+    // Exact in hex, so the replay converts with the same noise to the same codes
+    fprintf(recordFile, "volts %u %a\n", channel, volts);
+}
+
+void
+simTraceOutput(const char *format, ...)
+{
+    char line[LINE_LEN];
+    int length;
+    int i;
+    va_list args;
+
+    length = snprintf(line, sizeof(line), "%llu ", (unsigned long long)simCycles());
+    va_start(args, format);
+    length += vsnprintf(line + length, sizeof(line) - length, format, args);
+    va_end(args);
+    for (i = 0; i < length && line[i] != '\0'; i++) {
+        outputHash = (outputHash ^ (uint8_t)line[i]) * FNV_PRIME;
+    }
+    outputCount++;
+    if (outputFile != NULL) {
+        fprintf(outputFile, "%s\n", line);
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * simTrace.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Records the inputs the rig presents to the simulated board and
+ *      replays them into a later run, so a recorded flight can be re-flown through a
+ *      new firmware build without the rig model. The outputs the firmware produces are
+ *      folded into a hash, so two runs can be checked for a bit-exact match.
+ *
+ *      Traces are text, one change per line, timed in system clock cycles:
+ *          <cycle> gpio <port base> <pins> <levels>    rig drives pins to levels
+ *          <cycle> release <port base> <pins>          rig lets pins go to their pulls
+ *          <cycle> volts <channel> <hex float>         voltage presented from then on
+ *          <cycle> adc <channel> <code>                voltage converting to the code
+ *          <cycle> end                                 end of the recording
+ *      A cycle of '+' applies the line together with the one before it, as the rig
+ *      changed them in the same event.
+ */
+
+#ifndef SIMTRACE_H_
+#define SIMTRACE_H_
+
+//*****************************************************************************
+// Header files
+//*****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+//*****************************************************************************
+// @param inputs Stream to record every rig input to
+//
+// Start before the rig sets its power-on levels so the trace holds them too
+//*****************************************************************************
+void
+simTraceRecord(FILE *inputs);
+
+//*****************************************************************************
+// @param inputs A trace written by simTraceRecord()
+//
+// Drives the rig inputs from the trace instead of a rig model, stopping the run
+// with SIM_STOP_TIME where the recording ended
+//*****************************************************************************
+void
+simTraceReplay(FILE *inputs);
+
+//*****************************************************************************
+// Marks the end of the recording, call once the run has stopped
+//*****************************************************************************
+void
+simTraceFinish(void);
+
+//*****************************************************************************
+// @param outputs Stream to copy every output change to, timed like the inputs
+//*****************************************************************************
+void
+simTraceOutputs(FILE *outputs);
+
+//*****************************************************************************
+// @return uint64_t Number of output changes the firmware has made
+//*****************************************************************************
+uint64_t
+simTraceOutputCount(void);
+
+//*****************************************************************************
+// @return uint64_t FNV-1a hash of every output change and its cycle
+//*****************************************************************************
+uint64_t
+simTraceOutputHash(void);
+
+//*****************************************************************************
+// Hooks for the peripheral models
+//*****************************************************************************
+void
+simTraceGpio(uint32_t base, uint8_t pins, uint8_t levels, bool drive);
+
+void
+simTraceAdc(uint32_t channel, double volts);
+
+void
+simTraceOutput(const char *format, ...);
+
+#endif /* SIMTRACE_H_ */
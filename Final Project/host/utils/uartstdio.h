@@ -0,0 +1,12 @@
+/*
+ * uartstdio.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare UART stdio utility. The firmware
+ *      includes it but formats through ustdlib, so nothing is declared here.
+ */
+
+#ifndef __UARTSTDIO_H__
+#define __UARTSTDIO_H__
+
+#endif /* __UARTSTDIO_H__ */
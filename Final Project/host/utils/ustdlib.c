@@ -0,0 +1,76 @@
+/*
+ * ustdlib.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare small standard library. The
+ *      formatting and string functions are backed by the C library.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/ustdlib.h"
+#include "sim/simCore.h"
+
+//*****************************************************************************
+// Constants
+//*****************************************************************************
+#define FORMAT_CHAR_CYCLES 30       // Rough cost of formatting one character on the M4
+
+int
+usprintf(char *pcBuf, const char *pcString, ...)
+{
+    va_list vaArgP;
+    int length;
+    va_start(vaArgP, pcString);
+    length = vsprintf(pcBuf, pcString, vaArgP);
+    va_end(vaArgP);
+    simConsume(SIM_CALL_CYCLES + length * FORMAT_CHAR_CYCLES);
+    return length;
+}
+
+int
+usnprintf(char *pcBuf, uint32_t ui32Size, const char *pcString, ...)
+{
+    va_list vaArgP;
+    int length;
+    va_start(vaArgP, pcString);
+    length = uvsnprintf(pcBuf, ui32Size, pcString, vaArgP);
+    va_end(vaArgP);
+    return length;
+}
+
+int
+uvsnprintf(char *pcBuf, uint32_t ui32Size, const char *pcString, va_list vaArgP)
+{
+    int length = vsnprintf(pcBuf, ui32Size, pcString, vaArgP);
+    simConsume(SIM_CALL_CYCLES + length * FORMAT_CHAR_CYCLES);
+    return length;
+}
+
+uint32_t
+ustrtoul(const char *pcStr, const char **ppcStrRet, int iBase)
+{
+    char *end;
+    uint32_t value = strtoul(pcStr, &end, iBase);
+    if (ppcStrRet != NULL) {
+        *ppcStrRet = end;
+    }
+    simConsume(SIM_CALL_CYCLES + (end - pcStr) * FORMAT_CHAR_CYCLES);
+    return value;
+}
+
+int
+ustrncmp(const char *pcStr1, const char *pcStr2, size_t iCount)
+{
+    simConsume(SIM_CALL_CYCLES + iCount);
+    return strncmp(pcStr1, pcStr2, iCount);
+}
+
+size_t
+ustrlen(const char *pcStr)
+{
+    size_t length = strlen(pcStr);
+    simConsume(SIM_CALL_CYCLES + length);
+    return length;
+}
@@ -0,0 +1,23 @@
+/*
+ * ustdlib.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Host stand-in for the TivaWare small standard library. The
+ *      formatting and string functions are backed by the C library.
+ */
+
+#ifndef __USTDLIB_H__
+#define __USTDLIB_H__
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+int usprintf(char *pcBuf, const char *pcString, ...);
+int usnprintf(char *pcBuf, uint32_t ui32Size, const char *pcString, ...);
+int uvsnprintf(char *pcBuf, uint32_t ui32Size, const char *pcString, va_list vaArgP);
+uint32_t ustrtoul(const char *pcStr, const char **ppcStrRet, int iBase);
+int ustrncmp(const char *pcStr1, const char *pcStr2, size_t iCount);
+size_t ustrlen(const char *pcStr);
+
+#endif /* __USTDLIB_H__ */
@@ -9,6 +9,7 @@
  */
 
 #include "pidController.h"
+#include "sensors.h"
 
 //*******************************************************************************************
 // Static variables
@@ -17,6 +18,7 @@ static int32_t altitudeIntegral = 0;
 static int32_t yawIntegral = 0;
 static int32_t prevYawErr = 0;
 static bool yawControl = true;
+static sensorSnapshot_t sensors;    // Taken at the start of the cycle, for both controllers
 
 //*******************************************************************************************
 // PID controller for the altitude of the helicopter
@@ -24,7 +26,7 @@ static bool yawControl = true;
 void
 altitudeController(void) {
     // Gets the current error from the desired vs current altitude
-    int32_t error = getAltitudeError();
+    int32_t error = getAltitudeError(sensors.altitude);
     // removes underflow when adjusting pwm
     error = error * UNDERFLOW_ADJUSTMENT;
     // Calculates values for P, I and D control
@@ -62,7 +64,7 @@ void
 yawController(void) {
     // Checks if the state machine wants yawControl to be on or not for finding the reference
     if (yawControl) {
-        int32_t error = getYawError();
+        int32_t error = getYawError(sensors.yawAngle);
         // Removes underflow, since calculations use integers
         error = error * UNDERFLOW_ADJUSTMENT;
         // Calculates values for P, I and D control
@@ -86,10 +88,13 @@ yawController(void) {
 }
 
 //*******************************************************************************************
-// Task to assign to scheduler to run both controllers
+// Task to assign to scheduler to run both controllers. Takes the cycle's sensor snapshot
+// first, so both act on the same readings the other tasks see.
 //*******************************************************************************************
 void
 updateControl(void) {
+    updateSensors();
+    getSensorSnapshot(&sensors);
     altitudeController();
     yawController();
 }
@@ -30,11 +30,22 @@
 //*******************************************************************************************
 // Constants
 //*******************************************************************************************
+// Gains can be overridden from the build, e.g. by the host gain tuner
+#ifndef KP_ALTITUDE
 #define KP_ALTITUDE 6
+#endif
+#ifndef KI_ALTITUDE
 #define KI_ALTITUDE 3
+#endif
+#ifndef KP_YAW
 #define KP_YAW 12
+#endif
+#ifndef KI_YAW
 #define KI_YAW 3 //3
+#endif
+#ifndef KD_YAW
 #define KD_YAW 1
+#endif
 #define OUTPUT_MAX 70
 #define OUTPUT_MIN 3
 #define UNDERFLOW_ADJUSTMENT 100
@@ -53,8 +64,16 @@ void
 yawController(void);
 
 //*******************************************************************************************
-// Task to assign to scheduler to run both controllers
+// @param enable determines whether the yaw control is on or not
 //
+// Enables and disables control of the yaw angle
+//*******************************************************************************************
+void
+enableYawControl(bool enable);
+
+//*******************************************************************************************
+// Task to assign to scheduler to run both controllers. Takes the cycle's sensor snapshot
+// first, so both act on the same readings the other tasks see.
 //*******************************************************************************************
 void
 updateControl(void);
@@ -0,0 +1,408 @@
+/*
+ * profiler.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Module for profiling scheduler tasks and interrupt handlers. The
+ *      scheduler reads the DWT cycle counter either side of each task, so the profile
+ *      includes any interrupts that preempted the task, as they delay the tasks behind
+ *      it just the same. Interrupt run times leave out any handler nested inside, so the
+ *      time spent in interrupts each SysTick period is the sum of their run times.
+ */
+
+#include "profiler.h"
+#include "hardTier.h"
+#include "timeBase.h"
+#include "driverlib/interrupt.h"
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+static timeProfile_t profiles[NUMTASKS];
+static isrProfile_t isrProfiles[NUM_PROFILED_ISRS];
+static uint32_t nestedCycles[ISR_MAX_NESTING + 1]; // Time in handlers nested at each depth
+static uint32_t nesting;
+static uint32_t periodCycles;                       // Interrupt time this SysTick period
+static uint32_t budgetCycles;
+static isrBudget_t budget;
+static uint32_t cyclesPerUs;
+
+//*******************************************************************************************
+// @param cycles A measured time
+//
+// @return uint32_t The histogram bucket the time falls in
+//*******************************************************************************************
+static uint32_t
+bucketFor(uint32_t cycles)
+{
+    uint32_t bucket = 0;
+    cycles >>= PROFILE_BUCKET_SHIFT;
+    while (cycles > 0 && bucket < PROFILE_BUCKETS - 1) {
+        cycles >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+//*******************************************************************************************
+// @param profile Profile to add to
+//
+// @param cycles A measured time
+//*******************************************************************************************
+static void
+addTime(timeProfile_t *profile, uint32_t cycles)
+{
+    if (cycles < profile->minCycles) {
+        profile->minCycles = cycles;
+    }
+    if (cycles > profile->maxCycles) {
+        profile->maxCycles = cycles;
+        profile->maxAtUs = getTimeUs();
+    }
+    profile->totalCycles += cycles;
+    profile->runs++;
+    profile->histogram[bucketFor(cycles)]++;
+}
+
+//*******************************************************************************************
+// @param profile Profile to clear
+//*******************************************************************************************
+static void
+clearTimes(timeProfile_t *profile)
+{
+    uint32_t bucket;
+    profile->runs = 0;
+    profile->minCycles = UINT32_MAX;
+    profile->maxCycles = 0;
+    profile->maxAtUs = 0;
+    profile->totalCycles = 0;
+    for (bucket = 0; bucket < PROFILE_BUCKETS; bucket++) {
+        profile->histogram[bucket] = 0;
+    }
+}
+
+//*******************************************************************************************
+// @param buffer Buffer for the line
+//
+// @param length Size of the buffer
+//
+// @param name Label for the profile
+//
+// @param profile Profile to write
+//
+// @param histogram True for the histogram row, false for the summary
+//*******************************************************************************************
+static void
+formatTimes(char *buffer, size_t length, const char *name, const timeProfile_t *profile,
+            bool histogram)
+{
+    uint32_t bucket;
+    size_t used;
+
+    if (!histogram) {
+        if (profile->runs == 0) {
+            usnprintf(buffer, length, "%s none\r\n", name);
+        } else {
+            usnprintf(buffer, length, "%s n %d min %d avg %d max %d us at %d.%03d s\r\n",
+                      name, profile->runs, cyclesToUs(profile->minCycles),
+                      cyclesToUs((uint32_t)(profile->totalCycles / profile->runs)),
+                      cyclesToUs(profile->maxCycles),
+                      (uint32_t)(profile->maxAtUs / TIME_US_PER_SECOND),
+                      (uint32_t)(profile->maxAtUs % TIME_US_PER_SECOND / TIME_US_PER_MS));
+        }
+        return;
+    }
+    used = usnprintf(buffer, length, "%s hist <%d us x2:", name,
+                     cyclesToUs(1 << PROFILE_BUCKET_SHIFT));
+    for (bucket = 0; bucket < PROFILE_BUCKETS && used < length; bucket++) {
+        used += usnprintf(buffer + used, length - used, " %d", profile->histogram[bucket]);
+    }
+    if (used < length) {
+        usnprintf(buffer + used, length - used, "\r\n");
+    }
+}
+
+//*******************************************************************************************
+// @param buffer Buffer for the line
+//
+// @param length Size of the buffer
+//
+// @param tier Tier to summarise
+//
+// Writes the longest run and release to start latency of any task in the tier. For the
+// hard tier the latency is the timer's jitter.
+//*******************************************************************************************
+static void
+formatTier(char *buffer, size_t length, taskTier_t tier)
+{
+    uint32_t maxRunCycles = 0;
+    uint32_t maxLatencyCycles = 0;
+    uint32_t releases = 0;
+    size_t index;
+
+    for (index = 0; index < NUMTASKS; index++) {
+        const task_t* task = getTask(index);
+        if (taskTable[index].tier != tier) {
+            continue;
+        }
+        if (task->maxRunCycles > maxRunCycles) {
+            maxRunCycles = task->maxRunCycles;
+        }
+        if (task->maxLatencyCycles > maxLatencyCycles) {
+            maxLatencyCycles = task->maxLatencyCycles;
+        }
+        releases += task->releases;
+    }
+    if (tier == TIER_HARD) {
+        usnprintf(buffer, length, "Hard tier rel %d run max %d us jitter max %d us late %d\r\n",
+                  releases, cyclesToUs(maxRunCycles), cyclesToUs(maxLatencyCycles),
+                  getHardTierOverruns());
+    } else {
+        usnprintf(buffer, length, "Background tier rel %d run max %d us lat max %d us\r\n",
+                  releases, cyclesToUs(maxRunCycles), cyclesToUs(maxLatencyCycles));
+    }
+}
+
+//*******************************************************************************************
+// Starts the DWT cycle counter and clears the profiles
+//*******************************************************************************************
+void
+initProfiler(void)
+{
+    HWREG(DEMCR) |= DEMCR_TRCENA;
+    HWREG(DWT_CYCCNT) = 0;
+    HWREG(DWT_CTRL) |= DWT_CTRL_CYCCNTENA;
+    cyclesPerUs = SysCtlClockGet() / CYCLES_PER_US_DIVIDER;
+    setIsrBudget(ISR_BUDGET_US);
+    resetProfiles();
+}
+
+//*******************************************************************************************
+// @return uint32_t The cycle counter, to pass to profileTask() once the task returns
+//*******************************************************************************************
+uint32_t
+profileStart(void)
+{
+    return HWREG(DWT_CYCCNT);
+}
+
+//*******************************************************************************************
+// @param index Scheduler index of the task that ran
+//
+// @param startCycles The value profileStart() returned before the task ran
+//
+// @return uint32_t Cycles the run took
+//
+// Adds the run to the task profile. The counter wraps every 2^32 cycles, which the
+// unsigned subtraction handles for any task shorter than that.
+//*******************************************************************************************
+uint32_t
+profileTask(size_t index, uint32_t startCycles)
+{
+    uint32_t cycles = HWREG(DWT_CYCCNT) - startCycles;
+    addTime(&profiles[index], cycles);
+    return cycles;
+}
+
+//*******************************************************************************************
+// @param index Scheduler index of the task
+//
+// @return const timeProfile_t* The run times of the task since the last reset
+//*******************************************************************************************
+const timeProfile_t *
+getTaskProfile(size_t index)
+{
+    return &profiles[index];
+}
+
+//*******************************************************************************************
+// @param isr Interrupt being entered, call first thing in the handler
+//
+// @param latencyCycles Cycles since the interrupt was raised, or ISR_LATENCY_UNKNOWN to
+// record none
+//
+// @return uint32_t The cycle counter, to pass to isrExit()
+//
+// SysTick opens a new budget period, closing the one before. The hard tier is held off
+// while the nesting is counted, as it can preempt any other handler and counts itself in
+// the same nesting. Reading the counter inside the lock means that any hard-tier run
+// either comes first or is counted as nested.
+//*******************************************************************************************
+uint32_t
+isrEnter(profiledIsr_t isr, uint32_t latencyCycles)
+{
+    bool wasUnlocked = lockHardTier();
+    uint32_t startCycles = HWREG(DWT_CYCCNT);
+
+    if (latencyCycles != ISR_LATENCY_UNKNOWN) {
+        addTime(&isrProfiles[isr].latency, latencyCycles);
+    }
+
+    if (isr == ISR_SYSTICK) {
+        if (periodCycles > budget.worstCycles) {
+            budget.worstCycles = periodCycles;
+        }
+        if (periodCycles > budgetCycles) {
+            budget.overBudget++;
+            budget.lastOverUs = getTimeUs();
+        }
+        budget.ticks++;
+        periodCycles = 0;
+    }
+
+    if (nesting < ISR_MAX_NESTING) {
+        nesting++;
+        nestedCycles[nesting] = 0;
+    }
+    unlockHardTier(wasUnlocked);
+    return startCycles;
+}
+
+//*******************************************************************************************
+// @param isr Interrupt being left, call last thing in the handler
+//
+// @param startCycles The value isrEnter() returned
+//
+// Holds off the hard tier, as isrEnter() does
+//*******************************************************************************************
+void
+isrExit(profiledIsr_t isr, uint32_t startCycles)
+{
+    bool wasUnlocked = lockHardTier();
+    uint32_t totalCycles = HWREG(DWT_CYCCNT) - startCycles;
+    uint32_t ownCycles = totalCycles - nestedCycles[nesting];
+
+    addTime(&isrProfiles[isr].duration, ownCycles);
+    periodCycles += ownCycles;
+    if (nesting > 0) {
+        nesting--;
+        // Handlers below this one ran for less than their start-to-end time
+        nestedCycles[nesting] += totalCycles;
+    }
+    unlockHardTier(wasUnlocked);
+}
+
+//*******************************************************************************************
+// @param isr Profiled interrupt
+//
+// @return const isrProfile_t* The latencies and run times of the handler since the last reset
+//*******************************************************************************************
+const isrProfile_t *
+getIsrProfile(profiledIsr_t isr)
+{
+    return &isrProfiles[isr];
+}
+
+//*******************************************************************************************
+// @return const isrBudget_t* The SysTick periods that ran over the interrupt budget
+//*******************************************************************************************
+const isrBudget_t *
+getIsrBudget(void)
+{
+    return &budget;
+}
+
+//*******************************************************************************************
+// @param budgetUs Interrupt time allowed in each SysTick period, in microseconds
+//*******************************************************************************************
+void
+setIsrBudget(uint32_t budgetUs)
+{
+    budgetCycles = budgetUs * cyclesPerUs;
+}
+
+//*******************************************************************************************
+// @param cycles Cycle count
+//
+// @return uint32_t The cycle count in microseconds at the system clock
+//*******************************************************************************************
+uint32_t
+cyclesToUs(uint32_t cycles)
+{
+    return cycles / cyclesPerUs;
+}
+
+//*******************************************************************************************
+// Clears every task and interrupt profile and the budget counts. Interrupts are masked
+// so no handler adds to a half cleared profile.
+//*******************************************************************************************
+void
+resetProfiles(void)
+{
+    bool wasDisabled = IntMasterDisable();
+    size_t index;
+
+    for (index = 0; index < NUMTASKS; index++) {
+        clearTimes(&profiles[index]);
+    }
+    for (index = 0; index < NUM_PROFILED_ISRS; index++) {
+        clearTimes(&isrProfiles[index].latency);
+        clearTimes(&isrProfiles[index].duration);
+    }
+    budget.ticks = 0;
+    budget.overBudget = 0;
+    budget.lastOverUs = 0;
+    budget.worstCycles = 0;
+    periodCycles = 0;
+    if (!wasDisabled) {
+        IntMasterEnable();
+    }
+}
+
+//*******************************************************************************************
+// @param report Report to format: each task, each interrupt, the interrupt budget, then
+// the tiers
+//
+// @param line Line of the report, from 0
+//
+// @param buffer Buffer for the line, PROFILE_LINE_LEN characters is enough
+//
+// @param length Size of the buffer
+//
+// @return bool False once the report has no more lines, leaving the buffer untouched
+//
+// Formats one line of a profile report, times in microseconds. Each histogram row starts
+// at times under the first bucket limit and doubles the limit per column. A line at a time
+// lets the sender yield between them rather than block on the UART.
+//*******************************************************************************************
+bool
+formatProfileLine(size_t report, size_t line, char *buffer, size_t length)
+{
+    char name[PROFILE_NAME_LEN];
+
+    if (report < NUMTASKS) {
+        const task_t* task = getTask(report);
+
+        usnprintf(name, sizeof(name), "T%d", (uint32_t)report);
+        if (line < TASK_REPORT_LINES - 1) {
+            formatTimes(buffer, length, name, &profiles[report], line == 1);
+        } else if (line == TASK_REPORT_LINES - 1) {
+            usnprintf(buffer, length, "T%d rel %d trig %d drop %d over %d lat avg %d max %d us\r\n",
+                      (uint32_t)report, task->releases, task->triggered, task->dropped, task->overruns,
+                      task->starts > 0 ? cyclesToUs((uint32_t)(task->totalLatencyCycles / task->starts)) : 0,
+                      cyclesToUs(task->maxLatencyCycles));
+        } else {
+            return false;
+        }
+    } else if (report < NUMTASKS + NUM_PROFILED_ISRS) {
+        const isrProfile_t *isr = &isrProfiles[report - NUMTASKS];
+
+        if (line >= ISR_REPORT_LINES) {
+            return false;
+        }
+        // Latency then run time, each a summary and a histogram
+        usnprintf(name, sizeof(name), line < 2 ? "I%d lat" : "I%d run",
+                  (uint32_t)(report - NUMTASKS));
+        formatTimes(buffer, length, name, line < 2 ? &isr->latency : &isr->duration, line & 1);
+    } else if (report == NUMTASKS + NUM_PROFILED_ISRS && line == 0) {
+        usnprintf(buffer, length, "ISR over %d us: %d of %d ticks, last at %d.%03d s, worst %d us\r\n",
+                  cyclesToUs(budgetCycles), budget.overBudget, budget.ticks,
+                  (uint32_t)(budget.lastOverUs / TIME_US_PER_SECOND),
+                  (uint32_t)(budget.lastOverUs % TIME_US_PER_SECOND / TIME_US_PER_MS),
+                  cyclesToUs(budget.worstCycles));
+    } else if (report == NUMTASKS + NUM_PROFILED_ISRS + 1 && line < NUM_TASK_TIERS) {
+        formatTier(buffer, length, (taskTier_t)line);
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,193 @@
+/*
+ * profiler.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the profiler. Measures how long each scheduler task
+ *      and each interrupt handler runs with the Cortex-M4 DWT cycle counter, keeping the
+ *      min, max, mean and a histogram of the times. Interrupts also record how long they
+ *      waited to be serviced, and any SysTick period whose interrupts run over a budget
+ *      is counted.
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "inc/hw_types.h"
+#include "driverlib/sysctl.h"
+#include "utils/ustdlib.h"
+#include "scheduler.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+// Data Watchpoint and Trace unit, not covered by the TivaWare headers
+#define DEMCR 0xE000EDFC
+#define DEMCR_TRCENA 0x01000000
+#define DWT_CTRL 0xE0001000
+#define DWT_CTRL_CYCCNTENA 0x00000001
+#define DWT_CYCCNT 0xE0001004
+
+// Histogram bucket 0 holds times under 2^PROFILE_BUCKET_SHIFT cycles, each bucket after
+// doubles the limit and the last holds everything longer
+#define PROFILE_BUCKETS 12
+#define PROFILE_BUCKET_SHIFT 10
+#define PROFILE_LINE_LEN 128        // Longest report line, a histogram row
+#define PROFILE_NAME_LEN 16
+#define TASK_REPORT_LINES 3         // Times, histogram, release counts
+#define ISR_REPORT_LINES 4          // Latency and run time, each times and histogram
+// Reports formatProfileLine() cycles through: each task, each interrupt, the budget, then
+// the tiers
+#define NUM_PROFILE_REPORTS (NUMTASKS + NUM_PROFILED_ISRS + 2)
+#define CYCLES_PER_US_DIVIDER 1000000
+
+// Interrupt time allowed in each SysTick period before the period is flagged
+#define ISR_BUDGET_US 500
+// Passed to isrEnter() by handlers whose source leaves no record of when it fired
+#define ISR_LATENCY_UNKNOWN UINT32_MAX
+// Deepest interrupt nesting the profiler tracks
+#define ISR_MAX_NESTING 8
+
+//*******************************************************************************************
+// Profiled interrupt handlers
+//*******************************************************************************************
+typedef enum {
+    ISR_SYSTICK = 0,
+    ISR_ADC,
+    ISR_QUADRATURE,
+    ISR_REFERENCE,
+    ISR_UART,
+    ISR_HARD_TIER,
+    NUM_PROFILED_ISRS
+} profiledIsr_t;
+
+//*******************************************************************************************
+// Structs
+//*******************************************************************************************
+typedef struct {
+    uint32_t runs;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t maxAtUs;           // getTimeUs() when the max was recorded
+    uint64_t totalCycles;
+    uint32_t histogram[PROFILE_BUCKETS];
+} timeProfile_t;
+
+typedef struct {
+    timeProfile_t latency;      // Raised to handler entry, where the source records it
+    timeProfile_t duration;     // Handler run time, less any handlers nested inside it
+} isrProfile_t;
+
+typedef struct {
+    uint32_t ticks;             // SysTick periods measured
+    uint32_t overBudget;        // Periods whose interrupt time ran over the budget
+    uint64_t lastOverUs;        // getTimeUs() when a period last ran over
+    uint32_t worstCycles;       // Most interrupt time in any period
+} isrBudget_t;
+
+//*******************************************************************************************
+// Starts the DWT cycle counter and clears the profiles
+//*******************************************************************************************
+void
+initProfiler(void);
+
+//*******************************************************************************************
+// @return uint32_t The cycle counter, to pass to profileTask() once the task returns
+//*******************************************************************************************
+uint32_t
+profileStart(void);
+
+//*******************************************************************************************
+// @param index Scheduler index of the task that ran
+//
+// @param startCycles The value profileStart() returned before the task ran
+//
+// @return uint32_t Cycles the run took
+//*******************************************************************************************
+uint32_t
+profileTask(size_t index, uint32_t startCycles);
+
+//*******************************************************************************************
+// @param index Scheduler index of the task
+//
+// @return const timeProfile_t* The run times of the task since the last reset
+//*******************************************************************************************
+const timeProfile_t *
+getTaskProfile(size_t index);
+
+//*******************************************************************************************
+// @param isr Interrupt being entered, call first thing in the handler
+//
+// @param latencyCycles Cycles since the interrupt was raised, or ISR_LATENCY_UNKNOWN to
+// record none
+//
+// @return uint32_t The cycle counter, to pass to isrExit()
+//*******************************************************************************************
+uint32_t
+isrEnter(profiledIsr_t isr, uint32_t latencyCycles);
+
+//*******************************************************************************************
+// @param isr Interrupt being left, call last thing in the handler
+//
+// @param startCycles The value isrEnter() returned
+//*******************************************************************************************
+void
+isrExit(profiledIsr_t isr, uint32_t startCycles);
+
+//*******************************************************************************************
+// @param isr Profiled interrupt
+//
+// @return const isrProfile_t* The latencies and run times of the handler since the last reset
+//*******************************************************************************************
+const isrProfile_t *
+getIsrProfile(profiledIsr_t isr);
+
+//*******************************************************************************************
+// @return const isrBudget_t* The SysTick periods that ran over the interrupt budget
+//*******************************************************************************************
+const isrBudget_t *
+getIsrBudget(void);
+
+//*******************************************************************************************
+// @param budgetUs Interrupt time allowed in each SysTick period, in microseconds
+//*******************************************************************************************
+void
+setIsrBudget(uint32_t budgetUs);
+
+//*******************************************************************************************
+// @param cycles Cycle count
+//
+// @return uint32_t The cycle count in microseconds at the system clock
+//*******************************************************************************************
+uint32_t
+cyclesToUs(uint32_t cycles);
+
+//*******************************************************************************************
+// Clears every task and interrupt profile and the budget counts
+//*******************************************************************************************
+void
+resetProfiles(void);
+
+//*******************************************************************************************
+// @param report Report to format: each task, each interrupt, the interrupt budget, then
+// the tiers
+//
+// @param line Line of the report, from 0
+//
+// @param buffer Buffer for the line, PROFILE_LINE_LEN characters is enough
+//
+// @param length Size of the buffer
+//
+// @return bool False once the report has no more lines, leaving the buffer untouched
+//
+// Formats one line of a profile report, times in microseconds
+//*******************************************************************************************
+bool
+formatProfileLine(size_t report, size_t line, char *buffer, size_t length);
+
+#endif /* PROFILER_H_ */
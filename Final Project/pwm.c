@@ -9,6 +9,7 @@
  */
 
 #include "pwm.h"
+#include "hardTier.h"
 
 //*****************************************************************************
 // Static variables
@@ -143,11 +144,14 @@ initialiseYawPWM(void){
 }
 
 /********************************************************
- * Function to set the freq, duty cycle of M0PWM7
+ * Function to set the freq, duty cycle of M0PWM7.
+ * Both tiers set the duty, so the registers and the
+ * duty change together under the hard tier lock.
  ********************************************************/
 void
 setAltitudePwm (int32_t duty_update_val)
 {
+    bool wasUnlocked = lockHardTier();
     // Assign altitude duty to max duty (60%) when duty is greater that 60
     // Assign altitude duty to min duty (3%) when duty is less than 3
     altitude_duty = duty_update_val;
@@ -161,19 +165,22 @@ setAltitudePwm (int32_t duty_update_val)
 
     PWMGenPeriodSet(PWM_ALTITUDE_BASE, PWM_ALTITUDE_GEN, ui32Period);
     PWMPulseWidthSet(PWM_ALTITUDE_BASE, PWM_ALTITUDE_OUTNUM, ui32Period * altitude_duty / 100);
+    unlockHardTier(wasUnlocked);
 }
 
 /********************************************************
- * Function to set the freq, duty cycle of M1PWM5
+ * Function to set the freq, duty cycle of M1PWM5,
+ * under the hard tier lock as for setAltitudePwm()
  ********************************************************/
 void
 setYawPwm (int32_t duty_update_val)
 {
+    bool wasUnlocked = lockHardTier();
     // Assign yaw duty to max duty (60%) when duty is greater that 60
     // Assign yaw duty to min duty (3%) when duty is less than 3
     if (duty_update_val > PWM_MAX_DUTY) {
         duty_update_val = PWM_MAX_DUTY;
-    } else if (yaw_duty < PWM_MIN_DUTY) {
+    } else if (duty_update_val < PWM_MIN_DUTY) {
         duty_update_val = PWM_MIN_DUTY;
     }
 
@@ -183,6 +190,7 @@ setYawPwm (int32_t duty_update_val)
     PWMGenPeriodSet(PWM_YAW_BASE, PWM_YAW_GEN, ui32Period);
     PWMPulseWidthSet(PWM_YAW_BASE, PWM_YAW_OUTNUM, ui32Period * duty_update_val / 100);
     yaw_duty = duty_update_val;
+    unlockHardTier(wasUnlocked);
 }
 
 /********************************************************
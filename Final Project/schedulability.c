@@ -0,0 +1,272 @@
+/*
+ * schedulability.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Response time analysis of the task set under the scheduler's dispatch.
+ *      Tasks are released on SysTick and the highest priority ready task runs until it
+ *      returns or yields, so a task can be held up by one slice of a lower priority task
+ *      that started just before its release, by every release of the higher priority tasks
+ *      and by the interrupts. The bound iterates
+ *          R = B + C + sum over higher priority j of ceil(R / Tj) * Cj + ceil(R / Ttick) * I
+ *      to a fixed point, where B is the blocking slice, C the run time and I the interrupt
+ *      time in a SysTick period. Charging the higher priority tasks over the whole response
+ *      also covers tasks that yield, at the cost of some pessimism for those that do not.
+ *      Time spent in COROUTINE_WAIT_TICK() is not counted, so a task that waits on hardware
+ *      should have the lowest priority. Hard tier tasks run in their timer interrupt, so
+ *      they are never blocked by a background slice, and they interfere with every
+ *      background task whatever its priority. Their time is also part of the interrupt
+ *      time the profiler measures, which makes the measured bound slightly pessimistic.
+ */
+
+#include "schedulability.h"
+#include "profiler.h"
+#include "pwm.h"
+#include "utils/ustdlib.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+#define SCHEDULE_LINE_LEN 48
+
+//*******************************************************************************************
+// @return uint32_t System clock cycles in a SysTick period
+//*******************************************************************************************
+static uint32_t
+tickCycles(void)
+{
+    return SysCtlClockGet() / SYSTICK_RATE_HZ;
+}
+
+//*******************************************************************************************
+// @param demand Filled with the current period of each task and its priority from the
+// task table
+//*******************************************************************************************
+static void
+tableDemand(taskDemand_t demand[NUMTASKS])
+{
+    size_t index;
+    for (index = 0; index < NUMTASKS; index++) {
+        demand[index].periodCycles = getTask(index)->numTicksCycle * tickCycles();
+        demand[index].priority = taskTable[index].priority;
+        demand[index].tier = taskTable[index].tier;
+    }
+}
+
+//*******************************************************************************************
+// @param demand Filled with the current period of each task, and its priority and run time
+// budget from the task table. Budgets are charged as one slice, as a task may not yield.
+//*******************************************************************************************
+void
+budgetDemand(taskDemand_t demand[NUMTASKS])
+{
+    size_t index;
+    tableDemand(demand);
+    for (index = 0; index < NUMTASKS; index++) {
+        demand[index].runCycles = taskTable[index].wcetUs * (SysCtlClockGet() / US_PER_SECOND);
+        demand[index].sliceCycles = demand[index].runCycles;
+    }
+}
+
+//*******************************************************************************************
+// @param demand Filled with the current period and priority of each task, and the longest
+// release and longest slice it has run since initScheduler()
+//*******************************************************************************************
+void
+measuredDemand(taskDemand_t demand[NUMTASKS])
+{
+    size_t index;
+    tableDemand(demand);
+    for (index = 0; index < NUMTASKS; index++) {
+        demand[index].sliceCycles = getTaskProfile(index)->maxCycles;
+        demand[index].runCycles = getTask(index)->maxRunCycles;
+        // A release still part way through may have run the longest slice
+        if (demand[index].runCycles < demand[index].sliceCycles) {
+            demand[index].runCycles = demand[index].sliceCycles;
+        }
+    }
+}
+
+//*******************************************************************************************
+// @param demand Demand of each task
+//
+// @param isrCycles Most interrupt time in one SysTick period
+//
+// @return uint32_t Processor utilisation of the tasks and interrupts, in parts per thousand
+//*******************************************************************************************
+uint32_t
+scheduleUtilisation(const taskDemand_t demand[NUMTASKS], uint32_t isrCycles)
+{
+    uint64_t utilisation = (uint64_t)isrCycles * PER_MILLE / tickCycles();
+    size_t index;
+    for (index = 0; index < NUMTASKS; index++) {
+        utilisation += (uint64_t)demand[index].runCycles * PER_MILLE / demand[index].periodCycles;
+    }
+    return (uint32_t)utilisation;
+}
+
+//*******************************************************************************************
+// @param task Task being bounded
+//
+// @param other Another task
+//
+// @return bool True if other can run ahead of task once task is released
+//*******************************************************************************************
+static bool
+preempts(const taskDemand_t *task, const taskDemand_t *other)
+{
+    if (other->tier != task->tier) {
+        return other->tier == TIER_HARD;
+    }
+    return other->priority < task->priority;
+}
+
+//*******************************************************************************************
+// @param demand Demand of each task
+//
+// @return bool True if every task that runs ahead of another has a period no longer, so
+// the tiers and priorities are in rate monotonic order
+//*******************************************************************************************
+bool
+isRateMonotonic(const taskDemand_t demand[NUMTASKS])
+{
+    size_t i;
+    size_t j;
+    for (i = 0; i < NUMTASKS; i++) {
+        for (j = 0; j < NUMTASKS; j++) {
+            if (preempts(&demand[j], &demand[i])
+                    && demand[i].periodCycles > demand[j].periodCycles) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//*******************************************************************************************
+// @param demand Demand of each task
+//
+// @param isrCycles Most interrupt time in one SysTick period
+//
+// @param index Task to bound
+//
+// @param response Filled with the bound found for the task
+//*******************************************************************************************
+static void
+boundResponse(const taskDemand_t demand[NUMTASKS], uint32_t isrCycles, size_t index,
+              taskResponse_t *response)
+{
+    const taskDemand_t *task = &demand[index];
+    uint64_t busy;
+    uint64_t next;
+    uint32_t iteration;
+    size_t other;
+
+    // Only one lower priority background slice can be running when the task is released,
+    // and none can hold up the hard tier
+    response->blockingCycles = 0;
+    for (other = 0; other < NUMTASKS; other++) {
+        if (task->tier == TIER_BACKGROUND && demand[other].tier == TIER_BACKGROUND
+                && demand[other].priority > task->priority
+                && demand[other].sliceCycles > response->blockingCycles) {
+            response->blockingCycles = demand[other].sliceCycles;
+        }
+    }
+
+    busy = (uint64_t)response->blockingCycles + task->runCycles;
+    for (iteration = 0; iteration < SCHEDULE_MAX_ITERATIONS && busy <= task->periodCycles;
+            iteration++) {
+        next = (uint64_t)response->blockingCycles + task->runCycles
+               + (busy + tickCycles() - 1) / tickCycles() * isrCycles;
+        for (other = 0; other < NUMTASKS; other++) {
+            if (other != index && preempts(task, &demand[other])) {
+                next += (busy + demand[other].periodCycles - 1) / demand[other].periodCycles
+                        * demand[other].runCycles;
+            }
+        }
+        if (next == busy) {
+            break;
+        }
+        busy = next;
+    }
+    response->schedulable = busy <= task->periodCycles && iteration < SCHEDULE_MAX_ITERATIONS;
+    response->responseCycles = response->schedulable ? (uint32_t)busy : UINT32_MAX;
+}
+
+//*******************************************************************************************
+// @param demand Demand of each task
+//
+// @param isrCycles Most interrupt time in one SysTick period
+//
+// @param response Filled with the bound found for each task
+//
+// @return bool True if every task finishes within its period
+//*******************************************************************************************
+bool
+analyseSchedule(const taskDemand_t demand[NUMTASKS], uint32_t isrCycles,
+                taskResponse_t response[NUMTASKS])
+{
+    bool schedulable = true;
+    size_t index;
+    for (index = 0; index < NUMTASKS; index++) {
+        boundResponse(demand, isrCycles, index, &response[index]);
+        schedulable = schedulable && response[index].schedulable;
+    }
+    return schedulable;
+}
+
+//*******************************************************************************************
+// @param send Function that transmits a string, such as UARTSend()
+//
+// @return bool True if the task budgets in tasks.h are schedulable, with interrupts taking
+// up to ISR_BUDGET_US of every SysTick period. Each task that may miss its deadline is
+// reported through send.
+//*******************************************************************************************
+bool
+checkSchedule(void (*send)(char *))
+{
+    taskDemand_t demand[NUMTASKS];
+    taskResponse_t response[NUMTASKS];
+    uint32_t isrCycles = ISR_BUDGET_US * (SysCtlClockGet() / US_PER_SECOND);
+    char line[SCHEDULE_LINE_LEN];
+    uint32_t utilisation;
+    bool schedulable;
+    size_t index;
+
+    budgetDemand(demand);
+    schedulable = analyseSchedule(demand, isrCycles, response);
+    utilisation = scheduleUtilisation(demand, isrCycles);
+    for (index = 0; index < NUMTASKS; index++) {
+        if (!response[index].schedulable) {
+            usnprintf(line, sizeof(line), "T%d may miss its %d us deadline\r\n",
+                      (uint32_t)index, cyclesToUs(demand[index].periodCycles));
+            send(line);
+        }
+    }
+    usnprintf(line, sizeof(line), "Schedule %s, load %d.%d%%\r\n",
+              schedulable ? "ok" : "FAILS", utilisation / 10, utilisation % 10);
+    send(line);
+    return schedulable;
+}
+
+//*******************************************************************************************
+// @param index Index of the task
+//
+// @param rateHz Rate the task would be released at
+//
+// @return bool True if the task budgets would stay schedulable with the task at rateHz and
+// the rest at their current rates, checked like checkSchedule()
+//*******************************************************************************************
+bool
+checkTaskRate(size_t index, uint32_t rateHz)
+{
+    taskDemand_t demand[NUMTASKS];
+    taskResponse_t response[NUMTASKS];
+
+    if (index >= NUMTASKS || rateHz == 0 || rateHz > SYSTICK_RATE_HZ) {
+        return false;
+    }
+    budgetDemand(demand);
+    demand[index].periodCycles = SYSTICK_RATE_HZ / rateHz * tickCycles();
+    return analyseSchedule(demand, ISR_BUDGET_US * (SysCtlClockGet() / US_PER_SECOND),
+                           response);
+}
@@ -0,0 +1,117 @@
+/*
+ * schedulability.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the schedulability check of the task set. Bounds the
+ *      worst case response time of every task under the scheduler's dispatch, from each
+ *      task's period and run time, and checks each against its deadline, the end of its
+ *      period. Run at boot on the budgets in tasks.h, and by the heliSched host tool on
+ *      measured run times.
+ */
+
+#ifndef SCHEDULABILITY_H_
+#define SCHEDULABILITY_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "scheduler.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+#define US_PER_SECOND 1000000
+#define PER_MILLE 1000
+#define SCHEDULE_CHECK_AT_BOOT 1    // Check the task budgets at boot, 0 skips the check
+#define SCHEDULE_MAX_ITERATIONS 64  // Response time iterations before giving up on a task
+
+//*******************************************************************************************
+// Structs
+//*******************************************************************************************
+// What one task asks of the processor, all times in system clock cycles
+typedef struct {
+    uint32_t periodCycles;          // Time between releases, also the deadline
+    uint32_t runCycles;             // Run time of a whole release, all slices together
+    uint32_t sliceCycles;           // Longest run between yields, at most runCycles
+    uint8_t priority;               // 0 runs first, as in the task table
+    uint8_t tier;                   // taskTier_t, hard tier tasks preempt the background
+} taskDemand_t;
+
+// The bound found for one task
+typedef struct {
+    uint32_t blockingCycles;        // Longest slice of a lower priority task it can wait on
+    uint32_t responseCycles;        // Release to finish, UINT32_MAX if it has no bound
+    bool schedulable;               // The response time is within the period
+} taskResponse_t;
+
+//*******************************************************************************************
+// @param demand Filled with the current period of each task, and its priority and run time
+// budget from the task table. Budgets are charged as one slice, as a task may not yield.
+//*******************************************************************************************
+void
+budgetDemand(taskDemand_t demand[NUMTASKS]);
+
+//*******************************************************************************************
+// @param demand Filled with the current period and priority of each task, and the longest
+// release and longest slice it has run since initScheduler()
+//*******************************************************************************************
+void
+measuredDemand(taskDemand_t demand[NUMTASKS]);
+
+//*******************************************************************************************
+// @param demand Demand of each task
+//
+// @param isrCycles Most interrupt time in one SysTick period
+//
+// @return uint32_t Processor utilisation of the tasks and interrupts, in parts per thousand
+//*******************************************************************************************
+uint32_t
+scheduleUtilisation(const taskDemand_t demand[NUMTASKS], uint32_t isrCycles);
+
+//*******************************************************************************************
+// @param demand Demand of each task
+//
+// @return bool True if every task that runs ahead of another has a period no longer, so
+// the tiers and priorities are in rate monotonic order
+//*******************************************************************************************
+bool
+isRateMonotonic(const taskDemand_t demand[NUMTASKS]);
+
+//*******************************************************************************************
+// @param demand Demand of each task
+//
+// @param isrCycles Most interrupt time in one SysTick period
+//
+// @param response Filled with the bound found for each task
+//
+// @return bool True if every task finishes within its period
+//*******************************************************************************************
+bool
+analyseSchedule(const taskDemand_t demand[NUMTASKS], uint32_t isrCycles,
+                taskResponse_t response[NUMTASKS]);
+
+//*******************************************************************************************
+// @param send Function that transmits a string, such as UARTSend()
+//
+// @return bool True if the task budgets in tasks.h are schedulable, with interrupts taking
+// up to ISR_BUDGET_US of every SysTick period. Each task that may miss its deadline is
+// reported through send.
+//*******************************************************************************************
+bool
+checkSchedule(void (*send)(char *));
+
+//*******************************************************************************************
+// @param index Index of the task
+//
+// @param rateHz Rate the task would be released at
+//
+// @return bool True if the task budgets would stay schedulable with the task at rateHz and
+// the rest at their current rates, checked like checkSchedule()
+//*******************************************************************************************
+bool
+checkTaskRate(size_t index, uint32_t rateHz);
+
+#endif /* SCHEDULABILITY_H_ */
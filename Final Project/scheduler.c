@@ -9,71 +9,647 @@
  */
 
 #include "scheduler.h"
+#include "profiler.h"
+#include "eventQueue.h"
+#include "cpuLoad.h"
+#include "pwm.h"
+#include "hardTier.h"
+
+//*******************************************************************************************
+// How a task returned to the scheduler
+//*******************************************************************************************
+typedef enum {
+    RUN_COMPLETE = 0,       // Finished its release
+    RUN_YIELDED,            // Yielded part way, resume when it is the highest ready
+    RUN_WAITING             // Yielded part way, resume from the next tick
+} runResult_t;
 
 //*******************************************************************************************
 // Static Variables
 //*******************************************************************************************
-static task_t* taskList;
+static task_t taskList[NUMTASKS];
+static size_t taskAtPriority[SCHEDULER_PRIORITIES];   // Task index holding each priority
+static volatile uint32_t readyTasks;                // Ready bit of each task, by priority
+static volatile size_t runningTask = NO_TASK;
+static volatile uint32_t waitingTasks;              // Tasks to make ready on the next tick
+static runResult_t runningResult;                   // How the running task returned
+static uint32_t triggerMask[NUM_EVENT_TYPES];       // Task index bits each event releases
+static void (*faultHandler)(size_t index);
+static uint8_t tickLoad[SCHEDULER_MAX_HYPERPERIOD];  // Releases on each tick of the cycle
+static uint32_t tickCount;                          // Ticks since the scheduler started
+static uint32_t hardTickCount;                      // Hard tier ticks since it started
+static uint32_t worstTickLoad;
+static volatile uint32_t hardTierCycles;            // Hard tier task time, left to wrap
 
 //*******************************************************************************************
-// Creates a dynamically allocated task list for the scheduler to iterate through
+// @param index Index of the task to set
+//
+// @param phase Ticks into the cycle of each release, AUTO_PHASE for none yet
+//
+// Starts the tick count so the task is released when the ticks of its tier since the
+// scheduler started are phase more than a whole number of cycles. Interrupts must be masked
+// once SysTick runs.
+//*******************************************************************************************
+static void
+setTaskPhase(size_t index, uint16_t phase)
+{
+    uint16_t cycle = taskList[index].numTicksCycle;
+    uint32_t ticks = taskTable[index].tier == TIER_HARD ? hardTickCount : tickCount;
+    taskList[index].phase = phase;
+    if (phase == AUTO_PHASE) {
+        phase = 0;
+    }
+    taskList[index].currentTicks = (ticks % cycle + cycle - phase % cycle) % cycle;
+}
+
+//*******************************************************************************************
+// @param a First number
+//
+// @param b Second number
+//
+// @return size_t The greatest common divisor of the two
 //*******************************************************************************************
-void initialiseTaskList(void) {
-    taskList = malloc(NUMTASKS * sizeof(task_t));
-};
+static size_t
+greatestCommonDivisor(size_t a, size_t b)
+{
+    while (b != 0) {
+        size_t remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+    return a;
+}
 
+//*******************************************************************************************
+// @param hyperperiod Cycle the releases so far repeat over
+//
+// @param cycle Cycle of another task
+//
+// @return size_t The cycle the releases repeat over with the task added, cut short at
+// SCHEDULER_MAX_HYPERPERIOD
+//*******************************************************************************************
+static size_t
+extendHyperperiod(size_t hyperperiod, size_t cycle)
+{
+    hyperperiod = hyperperiod / greatestCommonDivisor(hyperperiod, cycle) * cycle;
+    return hyperperiod > SCHEDULER_MAX_HYPERPERIOD ? SCHEDULER_MAX_HYPERPERIOD : hyperperiod;
+}
 
 //*******************************************************************************************
-// Initialise each task for the scheduler
+// @param index Index of the task to place in the tick loads
+//
+// @param phase Phase to place it at
 //
-// @param functionToRun Pointer to the function the task completes.
+// @param hyperperiod Length of the cycle the loads cover
+//*******************************************************************************************
+static void
+placeTask(size_t index, size_t phase, size_t hyperperiod)
+{
+    size_t tick;
+    for (tick = phase; tick < hyperperiod; tick += taskList[index].numTicksCycle) {
+        tickLoad[tick]++;
+    }
+}
+
+//*******************************************************************************************
+// @param skip Task to leave out, or NO_TASK
+//
+// @param hyperperiod Length of the cycle the loads cover
+//
+// Lays out the tick loads of every background task that has a phase. Hard tier tasks run
+// on their own timer, so they share no ticks with the background tier.
+//*******************************************************************************************
+static void
+loadTicks(size_t skip, size_t hyperperiod)
+{
+    size_t index;
+    size_t tick;
+    for (tick = 0; tick < hyperperiod; tick++) {
+        tickLoad[tick] = 0;
+    }
+    for (index = 0; index < NUMTASKS; index++) {
+        if (index != skip && taskList[index].phase != AUTO_PHASE
+                && taskTable[index].tier == TIER_BACKGROUND) {
+            placeTask(index, taskList[index].phase, hyperperiod);
+        }
+    }
+}
+
+//*******************************************************************************************
+// @param cycle Cycle of the task to place
+//
+// @param hyperperiod Length of the cycle the loads cover
+//
+// @return size_t The phase whose busiest tick is least busy, and of those the one sharing
+// the fewest ticks, given the loads already laid out
+//*******************************************************************************************
+static size_t
+choosePhase(size_t cycle, size_t hyperperiod)
+{
+    size_t bestPhase = 0;
+    uint32_t bestWorst = UINT32_MAX;
+    uint32_t bestShared = UINT32_MAX;
+    size_t phase;
+    size_t tick;
+
+    for (phase = 0; phase < cycle && phase < hyperperiod; phase++) {
+        uint32_t worst = 0;
+        uint32_t shared = 0;
+        for (tick = phase; tick < hyperperiod; tick += cycle) {
+            if (tickLoad[tick] > worst) {
+                worst = tickLoad[tick];
+            }
+            shared += tickLoad[tick];
+        }
+        if (worst < bestWorst || (worst == bestWorst && shared < bestShared)) {
+            bestWorst = worst;
+            bestShared = shared;
+            bestPhase = phase;
+        }
+    }
+    return bestPhase;
+}
+
+//*******************************************************************************************
+// @param hyperperiod Length of the cycle the loads cover
 //
-// @param cycleLength Number of ticks to complete before being ready.
+// @return uint32_t The most releases on any tick of the loads laid out
+//*******************************************************************************************
+static uint32_t
+findWorstTickLoad(size_t hyperperiod)
+{
+    uint32_t worst = 0;
+    size_t tick;
+    for (tick = 0; tick < hyperperiod; tick++) {
+        if (tickLoad[tick] > worst) {
+            worst = tickLoad[tick];
+        }
+    }
+    return worst;
+}
+
+//*******************************************************************************************
+// Loads every task from the task table, ready for assignTaskPhases() and startScheduler()
 //*******************************************************************************************
 void
-initialiseTask(void(*functionToRun)(void), size_t cycleLength, size_t index)
+initScheduler(void)
 {
-    task_t* newTask = &taskList[index];
-    newTask->taskToComplete = functionToRun;
-    newTask->currentTicks = 0;
-    newTask->numTicksCycle = cycleLength;
-    newTask->completeFunc = false;
+    size_t index;
+    tickCount = 0;
+    hardTickCount = 0;
+    for (index = 0; index < NUMTASKS; index++) {
+        task_t* task = &taskList[index];
+        task->numTicksCycle = taskTable[index].numTicksCycle;
+        setTaskPhase(index, taskTable[index].phase);
+        task->policy = taskTable[index].policy;
+        task->backlog = 0;
+        task->suspended = false;
+        task->releases = 0;
+        task->triggered = 0;
+        task->dropped = 0;
+        task->overruns = 0;
+        task->faults = 0;
+        task->releaseCycles = 0;
+        task->maxLatencyCycles = 0;
+        task->totalLatencyCycles = 0;
+        task->starts = 0;
+        task->runCycles = 0;
+        task->maxRunCycles = 0;
+        task->tierCycles = 0;
+        taskAtPriority[taskTable[index].priority] = index;
+    }
+    for (index = 0; index < NUM_EVENT_TYPES; index++) {
+        triggerMask[index] = 0;
+    }
+    for (index = 0; index < NUMTASKS; index++) {
+        if (taskTable[index].trigger != NO_TRIGGER) {
+            triggerMask[taskTable[index].trigger] |= 1u << index;
+        }
+    }
+    readyTasks = 0;
+    waitingTasks = 0;
 }
 
 //*******************************************************************************************
-// Starts the while loop to run the scheduler. Complete tasks when the boolean in the struct
-// is true.
+// Chooses a phase for every task declared with AUTO_PHASE, keeping the rest. Fixed
+// phases are laid out first, then the automatic tasks in order of shortest cycle, as those
+// release most often. Each takes the phase whose busiest tick is least busy, and of those
+// the one sharing the fewest ticks. A cycle longer than SCHEDULER_MAX_HYPERPERIOD is cut
+// short, so the loads are then an estimate.
+//
+// @return uint32_t The most tasks released on any one tick
+//*******************************************************************************************
+uint32_t
+assignTaskPhases(void)
+{
+    size_t hyperperiod = 1;
+    size_t index;
+
+    for (index = 0; index < NUMTASKS; index++) {
+        hyperperiod = extendHyperperiod(hyperperiod, taskList[index].numTicksCycle);
+    }
+    loadTicks(NO_TASK, hyperperiod);
+
+    while (1) {
+        size_t next = NO_TASK;
+        size_t phase;
+
+        // Shortest cycle still to place
+        for (index = 0; index < NUMTASKS; index++) {
+            if (taskList[index].phase == AUTO_PHASE && (next == NO_TASK ||
+                    taskList[index].numTicksCycle < taskList[next].numTicksCycle)) {
+                next = index;
+            }
+        }
+        if (next == NO_TASK) {
+            break;
+        }
+        phase = choosePhase(taskList[next].numTicksCycle, hyperperiod);
+        if (taskTable[next].tier == TIER_BACKGROUND) {
+            placeTask(next, phase, hyperperiod);
+        }
+        setTaskPhase(next, phase);
+    }
+
+    worstTickLoad = findWorstTickLoad(hyperperiod);
+    return worstTickLoad;
+}
+
+//*******************************************************************************************
+// @param index Index of the task
+//
+// @param rateHz New release rate, which must divide SYSTICK_RATE_HZ
+//
+// @param phase Tick within the new cycle to release on, or AUTO_PHASE to take the one that
+// shares the fewest ticks with the other tasks
+//
+// @return bool False, leaving the task as it was, if the rate or phase cannot be used
+//
+// Changes the rate of a task while the scheduler runs. The phase is chosen with interrupts
+// enabled, then the cycle and tick count change together with them masked, so the SysTick
+// handler sees either the old cycle or the new one. A triggered task keeps its trigger,
+// and the rate only sets how long the tick waits for its events.
+//*******************************************************************************************
+bool
+setTaskRate(size_t index, uint32_t rateHz, uint16_t phase)
+{
+    size_t hyperperiod = 1;
+    size_t cycle;
+    size_t other;
+    bool wasDisabled;
+
+    if (index >= NUMTASKS || rateHz == 0 || SYSTICK_RATE_HZ % rateHz != 0) {
+        return false;
+    }
+    cycle = SYSTICK_RATE_HZ / rateHz;
+    if (phase != AUTO_PHASE && phase >= cycle) {
+        return false;
+    }
+    for (other = 0; other < NUMTASKS; other++) {
+        hyperperiod = extendHyperperiod(hyperperiod,
+                                        other == index ? cycle : taskList[other].numTicksCycle);
+    }
+    if (phase == AUTO_PHASE) {
+        loadTicks(index, hyperperiod);
+        phase = choosePhase(cycle, hyperperiod);
+    }
+
+    wasDisabled = IntMasterDisable();
+    taskList[index].numTicksCycle = cycle;
+    setTaskPhase(index, phase);
+    if (!wasDisabled) {
+        IntMasterEnable();
+    }
+
+    loadTicks(NO_TASK, hyperperiod);
+    worstTickLoad = findWorstTickLoad(hyperperiod);
+    return true;
+}
+
+//*******************************************************************************************
+// @return uint32_t The most tasks released on any one tick, as last found by
+// assignTaskPhases() or setTaskRate()
+//*******************************************************************************************
+uint32_t
+getWorstTickLoad(void)
+{
+    return worstTickLoad;
+}
+
+//*******************************************************************************************
+// @param index Index of the task
+//
+// @param policy What to do with a release that arrives before the last one has run,
+// TASK_SKIP by default
+//*******************************************************************************************
+void
+setTaskPolicy(size_t index, overrunPolicy_t policy)
+{
+    taskList[index].policy = policy;
+}
+
+//*******************************************************************************************
+// @param handler Called from the SysTick interrupt with the task index when a TASK_FAULT
+// task misses a release
+//*******************************************************************************************
+void
+setTaskFaultHandler(void (*handler)(size_t index))
+{
+    faultHandler = handler;
+}
+
+//*******************************************************************************************
+// @param index Index of the task
+//
+// @return const task_t* The task, with its release, drop, overrun and latency counts
+//*******************************************************************************************
+const task_t *
+getTask(size_t index)
+{
+    return &taskList[index];
+}
+
+//*******************************************************************************************
+// @param index Index of the task being released
+//
+// Marks the task ready, applying its policy if the last release has not run yet
+//*******************************************************************************************
+static void
+releaseTask(size_t index)
+{
+    task_t* task = &taskList[index];
+    uint32_t bit = PRIORITY_BIT(taskTable[index].priority);
+
+    task->releases++;
+    if (runningTask == index) {
+        task->overruns++;
+    }
+    if ((readyTasks | waitingTasks) & bit) {
+        if (task->policy == TASK_CATCH_UP && task->backlog < SCHEDULER_MAX_BACKLOG) {
+            task->backlog++;
+            return;
+        }
+        task->dropped++;
+        if (task->policy == TASK_FAULT) {
+            task->faults++;
+            if (faultHandler != NULL) {
+                faultHandler(index);
+            }
+        }
+        return;
+    }
+    task->releaseCycles = profileStart();
+    readyTasks |= bit;
+}
+
+//*******************************************************************************************
+// @param type Event an interrupt handler just posted
+//
+// Releases every task triggered by the event. The tick count restarts, so the tick only
+// releases the task if the events stop for a whole cycle.
+//*******************************************************************************************
+void
+releaseTriggered(eventType_t type)
+{
+    uint32_t tasks = triggerMask[type];
+    bool wasDisabled;
+    size_t index;
+
+    if (tasks == 0) {
+        return;
+    }
+    // Handlers of another priority than SysTick may post
+    wasDisabled = IntMasterDisable();
+    for (index = 0; tasks != 0; index++, tasks >>= 1) {
+        if (tasks & 1) {
+            taskList[index].currentTicks = 0;
+            taskList[index].triggered++;
+            releaseTask(index);
+        }
+    }
+    if (!wasDisabled) {
+        IntMasterEnable();
+    }
+}
+
+//*******************************************************************************************
+// Called by a coroutine task as it returns part way through, see coroutine.h
+//*******************************************************************************************
+void
+yieldTask(void)
+{
+    runningResult = RUN_YIELDED;
+}
+
+//*******************************************************************************************
+// Called by a coroutine task as it returns to wait on hardware, see coroutine.h
+//*******************************************************************************************
+void
+yieldTaskUntilTick(void)
+{
+    runningResult = RUN_WAITING;
+}
+
+//*******************************************************************************************
+// @param task Task about to start
+//
+// @param startCycles Cycle counter at the start
+//*******************************************************************************************
+static void
+recordLatency(task_t* task, uint32_t startCycles)
+{
+    uint32_t latency = startCycles - task->releaseCycles;
+    if (latency > task->maxLatencyCycles) {
+        task->maxLatencyCycles = latency;
+    }
+    task->totalLatencyCycles += latency;
+    task->starts++;
+}
+
+//*******************************************************************************************
+// Adds the time the hard tier tasks ran since the last pass to the CPU load, which is only
+// updated from the main loop
+//*******************************************************************************************
+static void
+accountHardTasks(void)
+{
+    size_t index;
+    for (index = 0; index < NUMTASKS; index++) {
+        if (taskTable[index].tier == TIER_HARD) {
+            uint32_t cycles;
+            bool wasDisabled = IntMasterDisable();
+            cycles = taskList[index].tierCycles;
+            taskList[index].tierCycles = 0;
+            if (!wasDisabled) {
+                IntMasterEnable();
+            }
+            addTaskCycles(index, cycles);
+        }
+    }
+}
+
+//*******************************************************************************************
+// Starts the while loop to run the scheduler. Each pass takes the highest priority ready
+// task from the ready bits with a count leading zeros, so the choice takes the same time
+// however many tasks there are, and a task that is always ready can only hold up tasks of
+// lower priority. Events posted by the interrupt handlers are handled first, in the order
+// they were posted. A task that yields stays ready, so it resumes once no higher priority
+// task is waiting, while one waiting for the tick is left out until the next tick. Sleeps
+// until the next interrupt when no task or event is waiting, counting the time asleep as
+// idle for the CPU load. Hard tier tasks run from their timer interrupt instead. Their time
+// goes to their own CPU load, so it is taken out of the load of any task they preempted,
+// though not out of that task's profile, whose run time they lengthened.
 //*******************************************************************************************
 void
 startScheduler(void) {
     while(1) {
-        size_t index = 0;
-        for (index = 0; index < NUMTASKS; index++) {
-            task_t* currentTask = &taskList[index];
-            if (currentTask->completeFunc) {
-                currentTask->completeFunc = false;
-                currentTask->taskToComplete();
-                break;
+        uint32_t priority;
+        size_t index;
+        task_t* task;
+        uint32_t startCycles;
+        uint32_t runCycles;
+        uint32_t hardStartCycles;
+        uint32_t hardEndCycles;
+        bool wasUnlocked;
+
+        // Events from the interrupt handlers come before any task
+        handleEvents();
+        accountHardTasks();
+        updateCpuLoad();
+
+        // Interrupts are masked so a release or event between the check and the WFI still
+        // wakes it, and so the tick interrupt cannot set a bit while this one is being cleared
+        IntMasterDisable();
+        if (readyTasks == 0) {
+            if (!eventsPending()) {
+                startCycles = profileStart();
+                CPUwfi();
+                addIdleCycles(profileStart() - startCycles);
             }
+            IntMasterEnable();
+            continue;
+        }
+        priority = COUNT_LEADING_ZEROS(readyTasks);
+        index = taskAtPriority[priority];
+        task = &taskList[index];
+        // A catch up task stays ready until its backlog is cleared, but resuming a
+        // coroutine carries on the run it already started
+        if (task->backlog > 0 && !task->suspended) {
+            task->backlog--;
+        } else {
+            readyTasks &= ~PRIORITY_BIT(priority);
+        }
+        runningTask = index;
+        runningResult = RUN_COMPLETE;
+        IntMasterEnable();
+
+        // Both counters are read with the hard tier held off, so a hard tier run is counted
+        // in both or in neither
+        wasUnlocked = lockHardTier();
+        startCycles = profileStart();
+        hardStartCycles = hardTierCycles;
+        unlockHardTier(wasUnlocked);
+        if (!task->suspended) {
+            recordLatency(task, startCycles);
         }
+        taskTable[index].taskToComplete();
+        wasUnlocked = lockHardTier();
+        runCycles = profileTask(index, startCycles);
+        hardEndCycles = hardTierCycles;
+        unlockHardTier(wasUnlocked);
+        addTaskCycles(index, runCycles - (hardEndCycles - hardStartCycles));
+        task->runCycles += runCycles;
+        if (runningResult == RUN_COMPLETE) {
+            if (task->runCycles > task->maxRunCycles) {
+                task->maxRunCycles = task->runCycles;
+            }
+            task->runCycles = 0;
+        }
+
+        IntMasterDisable();
+        task->suspended = runningResult != RUN_COMPLETE;
+        if (runningResult == RUN_WAITING) {
+            waitingTasks |= PRIORITY_BIT(priority);
+        } else if (task->suspended || task->backlog > 0) {
+            readyTasks |= PRIORITY_BIT(priority);
+        }
+        runningTask = NO_TASK;
+        IntMasterEnable();
     }
 
 }
 
 //*******************************************************************************************
 // Updates the system ticks for the scheduler and sets a task to run if the full cycle
-// for a task is complete
+// for a task is complete. Tasks waiting for the tick are made ready again. A triggered task
+// is given one tick beyond its cycle, so an event that is due is not beaten by the tick.
 //*******************************************************************************************
 void
 updateScheduleTicks(void)
 {
     size_t index = 0;
+    tickCount++;
     for (index = 0; index < NUMTASKS; index++) {
         task_t* currentTask = &taskList[index];
+        if (taskTable[index].tier == TIER_HARD) {
+            continue;
+        }
         currentTask->currentTicks++;
-        if (currentTask->currentTicks >= currentTask->numTicksCycle) {
+        if (currentTask->currentTicks >= currentTask->numTicksCycle
+                + (taskTable[index].trigger != NO_TRIGGER)) {
             currentTask->currentTicks = 0;
-            currentTask->completeFunc = true;
+            releaseTask(index);
+        }
+    }
+    readyTasks |= waitingTasks;
+    waitingTasks = 0;
+}
+
+//*******************************************************************************************
+// @param releaseCycles Cycle counter when the hard tier timer fired
+//
+// Counts a tick of the hard tier and runs every hard tier task whose cycle is complete,
+// highest priority first. A task's latency is from the timer firing, so it shows the jitter
+// of the tier. Called from the hard tier timer interrupt.
+//*******************************************************************************************
+void
+runHardTasks(uint32_t releaseCycles)
+{
+    uint32_t due = 0;
+    size_t index;
+
+    hardTickCount++;
+    for (index = 0; index < NUMTASKS; index++) {
+        task_t* task = &taskList[index];
+        if (taskTable[index].tier != TIER_HARD) {
+            continue;
+        }
+        task->currentTicks++;
+        if (task->currentTicks >= task->numTicksCycle) {
+            task->currentTicks = 0;
+            task->releases++;
+            task->releaseCycles = releaseCycles;
+            due |= PRIORITY_BIT(taskTable[index].priority);
+        }
+    }
+
+    while (due != 0) {
+        uint32_t priority = COUNT_LEADING_ZEROS(due);
+        task_t* task;
+        uint32_t startCycles;
+        uint32_t runCycles;
+
+        due &= ~PRIORITY_BIT(priority);
+        index = taskAtPriority[priority];
+        task = &taskList[index];
+        startCycles = profileStart();
+        recordLatency(task, startCycles);
+        taskTable[index].taskToComplete();
+        runCycles = profileTask(index, startCycles);
+        task->tierCycles += runCycles;
+        hardTierCycles += runCycles;
+        if (runCycles > task->maxRunCycles) {
+            task->maxRunCycles = runCycles;
         }
     }
 }
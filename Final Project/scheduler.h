@@ -17,49 +17,206 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include "driverlib/cpu.h"
+#include "driverlib/interrupt.h"
+#include "tasks.h"
+#include "eventQueue.h"
 
 //*******************************************************************************************
 // Constants
 //*******************************************************************************************
-#define NUMTASKS 5
+// One ready bit per priority, so priorities run from 0 (highest) to 31
+#define SCHEDULER_PRIORITIES 32
+#define PRIORITY_BIT(priority) (0x80000000u >> (priority))
+
+// Count leading zeros, a single CLZ instruction on the Cortex-M4
+#if defined(__TI_COMPILER_VERSION__)
+#define COUNT_LEADING_ZEROS(value) _norm(value)
+#else
+#define COUNT_LEADING_ZEROS(value) __builtin_clz(value)
+#endif
+
+// Most releases a catch up task can fall behind by before further ones are dropped
+#define SCHEDULER_MAX_BACKLOG 4
+#define NO_TASK NUMTASKS
+// Phase for assignTaskPhases() to choose
+#define AUTO_PHASE UINT16_MAX
+// Longest cycle of task releases assignTaskPhases() can lay out, in ticks
+#define SCHEDULER_MAX_HYPERPERIOD 600
+// Trigger of a task released only by the tick
+#define NO_TRIGGER NUM_EVENT_TYPES
+
+// Fails the build when condition is false, naming the check in the error
+#define STATIC_ASSERT(condition, name) typedef char static_assert_##name[(condition) ? 1 : -1]
+
+//*******************************************************************************************
+// What the scheduler does with a release that arrives before the last one has run
+//*******************************************************************************************
+typedef enum {
+    TASK_SKIP = 0,      // Drop it, the task runs once for both
+    TASK_CATCH_UP,      // Queue it, the task runs once per release up to SCHEDULER_MAX_BACKLOG
+    TASK_FAULT          // Drop it and call the fault handler
+} overrunPolicy_t;
+
+//*******************************************************************************************
+// Where a task runs
+//*******************************************************************************************
+typedef enum {
+    TIER_BACKGROUND = 0,    // Released on the tick or its trigger and run by startScheduler()
+    TIER_HARD,              // Run inside the hard tier timer interrupt, see hardTier.h
+    NUM_TASK_TIERS
+} taskTier_t;
 
 //*******************************************************************************************
 // Structs
 //*******************************************************************************************
+// One entry of the task table, fixed at build time so it sits in flash
 typedef struct {
     void(*taskToComplete)(void);
+    uint16_t numTicksCycle;
+    uint16_t phase;                 // Tick within the cycle of the first release, or AUTO_PHASE
+    uint8_t priority;
+    overrunPolicy_t policy;         // Policy the task starts with
+    uint32_t wcetUs;                // Worst case run time budget of a release
+    uint8_t trigger;                // Event that releases the task, or NO_TRIGGER
+    uint8_t tier;                   // taskTier_t the task runs in
+} taskConfig_t;
+
+// The state the scheduler keeps for each task while it runs
+typedef struct {
     uint16_t currentTicks;
-    size_t numTicksCycle;
-    bool completeFunc;
+    uint16_t numTicksCycle;         // Ticks between releases, from the table or setTaskRate()
+    uint16_t phase;                 // Tick within the cycle the task is released on
+    overrunPolicy_t policy;
+    uint8_t backlog;                // Releases waiting to run
+    bool suspended;                 // Yielded part way through a run, see coroutine.h
+    uint32_t releases;
+    uint32_t triggered;             // Releases made by its trigger event, not the tick
+    uint32_t dropped;               // Releases that never ran
+    uint32_t overruns;              // Releases that arrived while the task was still running
+    uint32_t faults;                // Releases that called the fault handler
+    uint32_t releaseCycles;         // Cycle counter at the release that made it ready
+    uint32_t maxLatencyCycles;      // Longest release to start
+    uint64_t totalLatencyCycles;
+    uint32_t starts;
+    uint32_t runCycles;             // Run time of the current release so far, over its slices
+    uint32_t maxRunCycles;          // Longest run time of a whole release
+    uint32_t tierCycles;            // Hard tier run time not yet added to the CPU load
 } task_t;
 
 //*******************************************************************************************
-// Creates a dynamically allocated task list for the scheduler to iterate through
+// The task set, built from TASK_TABLE in tasks.c
+//*******************************************************************************************
+extern const taskConfig_t taskTable[NUMTASKS];
+
+//*******************************************************************************************
+// Loads every task from the task table, ready for assignTaskPhases() and startScheduler()
+//*******************************************************************************************
+void
+initScheduler(void);
+
+//*******************************************************************************************
+// Chooses a phase for every task declared with AUTO_PHASE, keeping the rest, so that as
+// few releases as possible land on the same tick. Call after initScheduler() and before
+// the SysTick interrupt starts.
+//
+// @return uint32_t The most tasks released on any one tick
+//*******************************************************************************************
+uint32_t
+assignTaskPhases(void);
+
+//*******************************************************************************************
+// @return uint32_t The most tasks released on any one tick, as last found by
+// assignTaskPhases() or setTaskRate()
+//*******************************************************************************************
+uint32_t
+getWorstTickLoad(void);
+
+//*******************************************************************************************
+// @param index Index of the task
+//
+// @param rateHz New release rate, which must divide SYSTICK_RATE_HZ
+//
+// @param phase Tick within the new cycle to release on, or AUTO_PHASE to take the one that
+// shares the fewest ticks with the other tasks
+//
+// @return bool False, leaving the task as it was, if the rate or phase cannot be used
+//
+// Changes the rate of a task while the scheduler runs, safely against the SysTick handler.
+// Call from the main loop.
+//*******************************************************************************************
+bool
+setTaskRate(size_t index, uint32_t rateHz, uint16_t phase);
+
+//*******************************************************************************************
+// @param index Index of the task
+//
+// @param policy What to do with a release that arrives before the last one has run,
+// TASK_SKIP by default
+//*******************************************************************************************
+void
+setTaskPolicy(size_t index, overrunPolicy_t policy);
+
+//*******************************************************************************************
+// @param handler Called from the SysTick interrupt with the task index when a TASK_FAULT
+// task misses a release
 //*******************************************************************************************
-void initialiseTaskList(void);
+void
+setTaskFaultHandler(void (*handler)(size_t index));
 
 //*******************************************************************************************
-// Initialise each task for the scheduler
+// @param index Index of the task
 //
-// @param functionToRun Pointer to the function the task completes.
+// @return const task_t* The task, with its release, drop, overrun and latency counts
+//*******************************************************************************************
+const task_t *
+getTask(size_t index);
+
+//*******************************************************************************************
+// @param type Event an interrupt handler just posted
 //
-// @param cycleLength Number of ticks to complete before being ready.
+// Releases every task triggered by the event. Called by postEvent(), so from interrupt
+// handlers.
 //*******************************************************************************************
 void
-initialiseTask(void(*functionToRun)(void), size_t cycleLength, size_t index);
+releaseTriggered(eventType_t type);
 
 //*******************************************************************************************
-// Starts the while loop to run the scheduler. Complete tasks when the boolean in the struct
-// is true.
+// Called by a coroutine task as it returns part way through, so the scheduler resumes it
+// once no higher priority task is ready. See coroutine.h.
+//*******************************************************************************************
+void
+yieldTask(void);
+
+//*******************************************************************************************
+// As yieldTask(), but the task is not resumed before the next tick, so a task waiting on
+// hardware lets the processor sleep rather than polling
+//*******************************************************************************************
+void
+yieldTaskUntilTick(void);
+
+//*******************************************************************************************
+// Starts the while loop to run the scheduler. Runs the highest priority ready task, and
+// sleeps until the next interrupt when no task is ready. A task that yields stays ready.
 //*******************************************************************************************
 void
 startScheduler(void);
 
 //*******************************************************************************************
 // Updates the system ticks for the scheduler and sets a task to run if the full cycle
-// for a task is complete
+// for a task is complete. Hard tier tasks are left to runHardTasks().
 //*******************************************************************************************
 void
 updateScheduleTicks(void);
 
+//*******************************************************************************************
+// @param releaseCycles Cycle counter when the hard tier timer fired
+//
+// Counts a tick of the hard tier and runs every hard tier task whose cycle is complete,
+// highest priority first. Called from the hard tier timer interrupt, so the tasks preempt
+// the background tier and may not yield.
+//*******************************************************************************************
+void
+runHardTasks(uint32_t releaseCycles);
+
 #endif /* SCHEDULER_H_ */
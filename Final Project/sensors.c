@@ -0,0 +1,54 @@
+/*
+ * sensors.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Module keeps the sensor snapshot. It is only written from the hard
+ *      tier, which no reader can preempt, so the writer needs no lock. A background
+ *      reader can be preempted by it though, so readers copy the snapshot with the hard
+ *      tier held off and never see half of one cycle and half of the next. The yaw angle
+ *      and its tenths both come from the one encoder count read, so they always agree.
+ */
+
+#include "sensors.h"
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+static sensorSnapshot_t published;
+
+//*******************************************************************************************
+// Reads every sensor and publishes them as the new snapshot. Called at the start of each
+// control cycle from the hard tier, and once at boot before the tier starts.
+//*******************************************************************************************
+void
+updateSensors(void)
+{
+    sensorSnapshot_t next;
+
+    next.timeUs = getTimeUs();
+    next.altitudeTimeUs = getAdcOutputTimeUs();
+    next.cycle = published.cycle + 1;
+    next.altitude = processAltitude();
+    next.altitudeSetpoint = getAltitudeSetpoint();
+    next.yawCount = getYawCount();
+    next.yawAngle = yawCountToAngle(next.yawCount);
+    next.yawDecimal = yawCountToDecimal(next.yawCount);
+    next.yawSetpoint = getYawSetpoint();
+    next.altitudePwm = getAltitudePwm();
+    next.yawPwm = getYawPwm();
+    next.state = getState();
+    published = next;
+}
+
+//*******************************************************************************************
+// @param snapshot Filled with the latest snapshot
+//
+// Copies the whole snapshot in constant time. Safe from any task in either tier.
+//*******************************************************************************************
+void
+getSensorSnapshot(sensorSnapshot_t *snapshot)
+{
+    bool wasUnlocked = lockHardTier();
+    *snapshot = published;
+    unlockHardTier(wasUnlocked);
+}
@@ -0,0 +1,60 @@
+/*
+ * sensors.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the sensor snapshot. Once each control cycle the
+ *      altitude, yaw, rotor duties and state are read together into one snapshot, which
+ *      the controllers act on and every other task reads, so all of them see the same
+ *      values for that cycle instead of each converting the sensors again at a different
+ *      moment.
+ */
+
+#ifndef SENSORS_H_
+#define SENSORS_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include "altitude.h"
+#include "yaw.h"
+#include "pwm.h"
+#include "states.h"
+#include "hardTier.h"
+#include "timeBase.h"
+
+//*******************************************************************************************
+// Types
+//*******************************************************************************************
+typedef struct {
+    uint64_t timeUs;            // getTimeUs() when the snapshot was taken
+    uint64_t altitudeTimeUs;    // Input time of altitude, allowing for the filter's delay
+    uint32_t cycle;             // Snapshots taken before this one
+    int32_t altitude;           // Percent above the initial altitude
+    int32_t altitudeSetpoint;
+    int16_t yawCount;           // Encoder slots from the reference
+    int16_t yawAngle;           // Whole degrees of yawCount
+    int16_t yawDecimal;         // Tenths of a degree of yawCount
+    int16_t yawSetpoint;
+    int32_t altitudePwm;        // Duties in force as the sensors were read
+    int32_t yawPwm;
+    helicopterState_t state;
+} sensorSnapshot_t;
+
+//*******************************************************************************************
+// Reads every sensor and publishes them as the new snapshot. Called at the start of each
+// control cycle from the hard tier, and once at boot before the tier starts.
+//*******************************************************************************************
+void
+updateSensors(void);
+
+//*******************************************************************************************
+// @param snapshot Filled with the latest snapshot
+//
+// Copies the whole snapshot in constant time. Safe from any task in either tier.
+//*******************************************************************************************
+void
+getSensorSnapshot(sensorSnapshot_t *snapshot);
+
+#endif /* SENSORS_H_ */
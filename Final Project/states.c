@@ -9,14 +9,15 @@
  */
 
 #include "states.h"
+#include "sensors.h"
+#include "pidController.h"
 
 /**********************************************************
  * Static variables
  **********************************************************/
 static helicopterState_t state;     // Stores the current state of the helicopter
 
-static bool landingCheckForRef = 0; // Binary flag for detecting the yaw reference
-static bool checkForReference = 0;  // Binary flag for detecting the yaw reference
+static bool takeoffSwitchUp = false; // Last position of the takeoff switch
 
 /**********************************************************
  * @return helicopterState_t
@@ -40,7 +41,16 @@ void setState (helicopterState_t heliState)
  * heliStateStr() returns a string of the current helicopter state
  **********************************************************/
 char* heliStateStr(void) {
-    switch (state) {
+    return heliStateName(state);
+}
+
+/**********************************************************
+ * @param heliState A helicopter state
+ * @return char*
+ * heliStateName() returns a string of the given helicopter state
+ **********************************************************/
+char* heliStateName(helicopterState_t heliState) {
+    switch (heliState) {
         case LANDED: return "Landed";
         case TAKING_OFF: return "Taking off";
         case FLYING: return "Flying";
@@ -51,37 +61,66 @@ char* heliStateStr(void) {
 }
 
 /**********************************************************
- * checkButtonState() checks the state of the helicopter then the
- * state of the buttons if the helicopter is FLYING and
- * updates altitude and yaw with the defined step values
+ * @param event An EVENT_BUTTON
+ * buttonEventHandler() updates altitude and yaw with the defined
+ * step values when a button is pushed while FLYING
  **********************************************************/
-void checkButtonState (void)
+void buttonEventHandler (const event_t *event)
 {
-    if (getState() == FLYING) {
+    if (getState() != FLYING || event->value != PUSHED) {
+        return;
+    }
+    switch (event->source) {
         // Increase altitude by 10%
         // Set altitude PWM
-        if (checkButton(UP) == PUSHED) {
+        case UP:
             updateAltitude(ALTITUDE_INCREASE);
             setAltitudePwm(ALTITUDE_DUTY_STEP);
-        }
+            break;
         // Decrease altitude by 10%
         // Set altitude PWM
-        if (checkButton(DOWN) == PUSHED) {
+        case DOWN:
             updateAltitude(ALTITUDE_DECREASE);
             setAltitudePwm(-ALTITUDE_DUTY_STEP);
-        }
+            break;
         // Increase yaw by 15 degrees
         // Set yaw PWM
-        if (checkButton(RIGHT) == PUSHED) {
+        case RIGHT:
             setYawSetpoint(YAW_INCREASE);
             setYawPwm(YAW_DUTY_STEP);
-        }
+            break;
         // Decrease altitude by 15 degrees
         // Set yaw PWM
-        if (checkButton(LEFT) == PUSHED) {
+        case LEFT:
             setYawSetpoint(YAW_DECREASE);
             setYawPwm(-YAW_DUTY_STEP);
-        }
+            break;
+    }
+}
+
+/**********************************************************
+ * @param event An EVENT_SWITCH from the takeoff switch
+ * switchEventHandler() records the takeoff switch position.
+ * The reset switch is acted on in the SysTick handler instead
+ **********************************************************/
+void switchEventHandler (const event_t *event)
+{
+    takeoffSwitchUp = (event->value == SWITCH_UP);
+}
+
+/**********************************************************
+ * @param event An EVENT_REFERENCE
+ * referenceEventHandler() moves on from the states that spin
+ * the helicopter to find the yaw reference
+ **********************************************************/
+void referenceEventHandler (const event_t *event)
+{
+    (void)event;
+    if (getState() == TAKING_OFF) {
+        setState(FLYING);
+    } else if (getState() == FINDING_REF) {
+        enableYawControl(true);
+        setState(LANDING);
     }
 }
 
@@ -92,7 +131,10 @@ void checkButtonState (void)
 void
 stateMachine(void)
 {
+    sensorSnapshot_t sensors;
     helicopterState_t helicopterState = getState();
+
+    getSensorSnapshot(&sensors);
     switch(helicopterState) {
         // Stop all PWM output
         // Poll to check if the switch state has changed to UP
@@ -100,7 +142,7 @@ stateMachine(void)
         case LANDED:
             stopTailPWM();
             stopMainPWM();
-            if (checkSwitch(RIGHT_SWITCH) == SWITCH_UP) {
+            if (takeoffSwitchUp) {
                 setState(TAKING_OFF);
             }
             break;
@@ -108,16 +150,13 @@ stateMachine(void)
         // Start main and tail rotor PWM output
         // Hover at 10% altitude
         // Disable yaw control for finding reference yaw
-        // Change to FLYING once reference yaw found
+        // referenceEventHandler() changes to FLYING once reference yaw found
         case TAKING_OFF:
             startTailPWM();
             startMainPWM();
             enableYawControl(false);
             setAltitudeValue(HOVER_ALTITUDE);
-            checkForReference = fullRevolution();
-            if (checkForReference) {
-                setState(FLYING);
-            }
+            fullRevolution();
             break;
 
         // Ensure PWM is on
@@ -128,28 +167,23 @@ stateMachine(void)
             startTailPWM();
             startMainPWM();
             enableYawControl(true);
-            if (checkSwitch(RIGHT_SWITCH) == SWITCH_DOWN) {
+            if (!takeoffSwitchUp) {
                 setState(FINDING_REF);
-                updateReference();
             }
             break;
 
         // Look for the reference yaw
-        // Change to LANDING once reference yaw found
+        // referenceEventHandler() changes to LANDING once reference yaw found
         case FINDING_REF:
-            landingCheckForRef = fullRevolution();
+            fullRevolution();
             enableYawControl(false);
-            if (landingCheckForRef) {
-                enableYawControl(true);
-                setState(LANDING);
-            }
             break;
 
         // Change to landing PWM
         // Change to LANDED when altitude <= 1
         case LANDING:
             setAltitudePwm(LANDING_PWM);
-            if (processAltitude() <= 1) {
+            if (sensors.altitude <= 1) {
                 setState(LANDED);
             }
             break;
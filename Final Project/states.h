@@ -35,6 +35,7 @@
 #include "yaw.h"
 #include "switches.h"
 #include "display.h"
+#include "eventQueue.h"
 
 /**********************************************************
  * Constants
@@ -78,11 +79,32 @@ void setState (helicopterState_t state);
 char* heliStateStr(void);
 
 /**********************************************************
- * checkButtonState() checks the state of the helicopter then the
- * state of the buttons if the helicopter is FLYING and
- * updates altitude and yaw with the defined step values
+ * @param heliState A helicopter state
+ * @return char*
+ * heliStateName() returns a string of the given helicopter state
+ **********************************************************/
+char* heliStateName(helicopterState_t heliState);
+
+/**********************************************************
+ * @param event An EVENT_BUTTON
+ * buttonEventHandler() updates altitude and yaw with the defined
+ * step values when a button is pushed while FLYING
+ **********************************************************/
+void buttonEventHandler (const event_t *event);
+
+/**********************************************************
+ * @param event An EVENT_SWITCH from the takeoff switch
+ * switchEventHandler() records the takeoff switch position.
+ * The reset switch is acted on in the SysTick handler instead
+ **********************************************************/
+void switchEventHandler (const event_t *event);
+
+/**********************************************************
+ * @param event An EVENT_REFERENCE
+ * referenceEventHandler() moves on from the states that spin
+ * the helicopter to find the yaw reference
  **********************************************************/
-void checkButtonState (void);
+void referenceEventHandler (const event_t *event);
 
 /**********************************************************
  * stateMachine() sets the helicopter functionality based on
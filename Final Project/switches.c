@@ -16,7 +16,6 @@
  **********************************************************/
 static bool switch_state[NUM_SWITCHES];     // Stores the state for each switch
 static uint8_t switch_count[NUM_SWITCHES];  // Debouncing
-static bool switch_flag[NUM_SWITCHES];      // Binary flag indicating if a switch value has changed
 static bool switch_normal[NUM_SWITCHES];    // Default state of switch
 
 /**********************************************************
@@ -40,7 +39,6 @@ initSwitch(void)
         {
         switch_state[i] = switch_normal[i];
         switch_count[i] = 0;
-        switch_flag[i] = false;
         }
 }
 
@@ -68,7 +66,9 @@ getSwitchTwoValue(void)
  * Updates the switch values
  * Change in switch state only occurs after NUM_SWITCH_POLLS have read the
  * switch in the opposite direction
- * Switch state is then changed and switch_flag is set
+ * Switch state is then changed. The reset switch resets the system
+ * here, in interrupt context, so it works even if the main loop
+ * has hung; a takeoff switch change is posted as an EVENT_SWITCH
  **********************************************************/
 void
 updateSwitches(void) {
@@ -87,45 +87,17 @@ updateSwitches(void) {
             if (switch_count[i] >= NUM_SWITCH_POLLS)
             {
                 switch_state[i] = switch_value[i];
-                switch_flag[i] = true;    // Reset by call to checkSwitch()
                 switch_count[i] = 0;
+                if (i == LEFT_SWITCH) {
+                    if (switch_state[i] != switch_normal[i]) {
+                        SysCtlReset();
+                    }
+                } else {
+                    postEvent(EVENT_SWITCH, i, switch_state[i] == switch_normal[i] ? SWITCH_UP : SWITCH_DOWN);
+                }
             }
         }
         else
             switch_count[i] = 0;
     }
 }
-
-
-/**********************************************************
- * @return uint8_t
- * @param switch number
- * checkSwitch returns the new switch logical state if the switch state
- * (SWITCH_UP, SWITCH_DOWN) has changed otherwise return SWITCH_UNCHANGED
- **********************************************************/
-
-uint8_t
-checkSwitch (uint8_t switchName)
-{
-    if (switch_flag[switchName])
-    {
-        switch_flag[switchName] = false;
-        if (switch_state[switchName] == switch_normal[switchName])
-            return SWITCH_UP;
-        else
-            return SWITCH_DOWN;
-    }
-    return SWITCH_NO_CHANGE;
-}
-
-/**********************************************************
- * Check if reset switch is HIGH
- * Calls SysCtlReset() to reset system
- **********************************************************/
-void
-checkResetSwitch() {
-    if (checkSwitch(LEFT_SWITCH) == SWITCH_DOWN) {
-        SysCtlReset();
-    }
-}
-
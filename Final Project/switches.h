@@ -27,6 +27,7 @@
 #include "inc/hw_ints.h"
 #include "yaw.h"
 #include "states.h"
+#include "eventQueue.h"
 
 /**********************************************************
  * Constants
@@ -71,25 +72,11 @@ getSwitchTwoValue(void);
  * Updates the switch values
  * Change in switch state only occurs after NUM_SWITCH_POLLS have read the
  * switch in the opposite direction
- * Switch state is then changed and switch_flag is set
+ * Switch state is then changed. The reset switch resets the system
+ * here, in interrupt context, so it works even if the main loop
+ * has hung; a takeoff switch change is posted as an EVENT_SWITCH
  **********************************************************/
 void
 updateSwitches(void);
 
-/**********************************************************
- * Check if reset switch is HIGH
- * Calls SysCtlReset() to reset system
- **********************************************************/
-void
-checkResetSwitch(void);
-
-/**********************************************************
- * @return uint8_t
- * @param switch number
- * checkSwitch returns the new switch logical state if the switch state
- * (SWITCH_UP, SWITCH_DOWN) has changed otherwise return SWITCH_UNCHANGED
- **********************************************************/
-uint8_t
-checkSwitch (uint8_t switchName);
-
 #endif /* SWITCHES_H_ */
@@ -0,0 +1,62 @@
+/*
+ * tasks.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Builds the scheduler's task table from TASK_TABLE. The table is const so
+ *      it is placed in flash, and each entry is checked when the firmware is built.
+ */
+
+#include "tasks.h"
+#include "scheduler.h"
+#include "pwm.h"
+#include "pidController.h"
+#include "states.h"
+#include "display.h"
+#include "uartHeli.h"
+#include "schedulability.h"
+#include "altitude.h"
+
+//*******************************************************************************************
+// Task table
+//*******************************************************************************************
+#define TASK_CONFIG(index, function, rateHz, phase, priority, policy, wcetUs, trigger, tier) \
+    [index] = {function, SYSTICK_RATE_HZ / (rateHz), phase, priority, policy, wcetUs, trigger, tier},
+
+const taskConfig_t taskTable[NUMTASKS] = {
+    TASK_TABLE(TASK_CONFIG)
+};
+
+//*******************************************************************************************
+// Build time checks of each task: its rate gives a whole number of ticks, its priority
+// has a ready bit, its phase lies within its cycle, its budget fits its period, its
+// trigger is an event and a hard tier task has none
+//*******************************************************************************************
+#define TASK_CHECKS(index, function, rateHz, phase, priority, policy, wcetUs, trigger, tier) \
+    STATIC_ASSERT((rateHz) > 0 && SYSTICK_RATE_HZ % (rateHz) == 0, index##_rate_divides_systick); \
+    STATIC_ASSERT((priority) < SCHEDULER_PRIORITIES, index##_priority_in_range); \
+    STATIC_ASSERT((phase) == AUTO_PHASE || (phase) < SYSTICK_RATE_HZ / (rateHz), index##_phase_in_cycle); \
+    STATIC_ASSERT((wcetUs) > 0 && (uint64_t)(wcetUs) * (rateHz) < US_PER_SECOND, index##_budget_fits_period); \
+    STATIC_ASSERT((trigger) <= NO_TRIGGER, index##_trigger_is_event); \
+    STATIC_ASSERT((tier) == TIER_BACKGROUND || ((tier) == TIER_HARD && (trigger) == NO_TRIGGER), \
+                  index##_hard_tier_untriggered);
+
+TASK_TABLE(TASK_CHECKS)
+
+// Adding the priority bits only matches or-ing them if no two tasks share a priority
+#define PRIORITY_SUM(index, function, rateHz, phase, priority, policy, wcetUs, trigger, tier) + (1ull << (priority))
+#define PRIORITY_OR(index, function, rateHz, phase, priority, policy, wcetUs, trigger, tier) | (1ull << (priority))
+
+STATIC_ASSERT((0 TASK_TABLE(PRIORITY_SUM)) == (0 TASK_TABLE(PRIORITY_OR)), task_priorities_unique);
+STATIC_ASSERT(NUMTASKS <= SCHEDULER_PRIORITIES, tasks_fit_ready_bits);
+
+// The ADC posts EVENT_ADC_SAMPLES at the control rate, so the gains see the same update rate
+// if the control task is moved to the background tier with that event as its trigger
+STATIC_ASSERT(SAMPLE_RATE_HZ / ADC_EVENT_SAMPLES == CONTROL_RATE_HZ
+              && SAMPLE_RATE_HZ % ADC_EVENT_SAMPLES == 0, adc_events_at_control_rate);
+
+// The budgets can only be met if together they leave the processor some idle time. Whether
+// each task also meets its deadline is left to checkSchedule() at boot.
+#define TASK_UTILISATION(index, function, rateHz, phase, priority, policy, wcetUs, trigger, tier) \
+    + (uint64_t)(wcetUs) * (rateHz)
+
+STATIC_ASSERT((0 TASK_TABLE(TASK_UTILISATION)) < US_PER_SECOND, task_set_utilisation);
@@ -0,0 +1,60 @@
+/*
+ * tasks.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the task set the scheduler runs. Each task is declared
+ *      once in TASK_TABLE, which gives its index, the table in tasks.c and NUMTASKS, so the
+ *      three can never disagree.
+ */
+
+#ifndef TASKS_H_
+#define TASKS_H_
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+// Task rates, each must divide SYSTICK_RATE_HZ
+#define CONTROL_RATE_HZ 15
+#define DISPLAY_RATE_HZ 10
+#define STATE_MACHINE_RATE_HZ 15
+#define UART_RATE_HZ 2
+
+// Task priorities, 0 runs first when several tasks are ready
+#define CONTROL_PRIORITY 0
+#define STATE_MACHINE_PRIORITY 1
+#define DISPLAY_PRIORITY 2
+#define UART_PRIORITY 3
+
+// Worst case run time budget of each release, all slices together, for the schedulability
+// check. Measured times are checked against these by the heliSched host tool.
+#define CONTROL_WCET_US 500
+#define DISPLAY_WCET_US 10000
+#define STATE_MACHINE_WCET_US 200
+#define UART_WCET_US 2000
+
+//*******************************************************************************************
+// The task set, one TASK(index, function, rate in Hz, phase, priority, overrun policy,
+// run time budget in us, trigger, tier) per task. A phase of AUTO_PHASE leaves the choice to
+// assignTaskPhases(). A trigger other than NO_TRIGGER releases the task as soon as an
+// interrupt posts that event, with the rate kept as a fallback for when the events stop.
+// The events must come no faster than the rate, which the schedulability check assumes.
+// A TIER_HARD task runs in the hard tier timer interrupt at exactly its rate, preempting
+// the background tier, so it takes no trigger and must not yield. Priorities order the
+// hard tier tasks among themselves.
+//*******************************************************************************************
+#define TASK_TABLE(TASK) \
+    TASK(CONTROL_TASK, updateControl, CONTROL_RATE_HZ, 0, CONTROL_PRIORITY, TASK_SKIP, CONTROL_WCET_US, NO_TRIGGER, TIER_HARD) \
+    TASK(DISPLAY_TASK, displaySchedulerFunc, DISPLAY_RATE_HZ, AUTO_PHASE, DISPLAY_PRIORITY, TASK_SKIP, DISPLAY_WCET_US, NO_TRIGGER, TIER_BACKGROUND) \
+    TASK(STATE_MACHINE_TASK, stateMachine, STATE_MACHINE_RATE_HZ, AUTO_PHASE, STATE_MACHINE_PRIORITY, TASK_SKIP, STATE_MACHINE_WCET_US, NO_TRIGGER, TIER_BACKGROUND) \
+    TASK(UART_TASK, updateUART, UART_RATE_HZ, AUTO_PHASE, UART_PRIORITY, TASK_SKIP, UART_WCET_US, NO_TRIGGER, TIER_BACKGROUND)
+
+//*******************************************************************************************
+// Task indices, in table order
+//*******************************************************************************************
+#define TASK_INDEX(index, function, rateHz, phase, priority, policy, wcetUs, trigger, tier) index,
+typedef enum {
+    TASK_TABLE(TASK_INDEX)
+    NUMTASKS
+} taskIndex_t;
+
+#endif /* TASKS_H_ */
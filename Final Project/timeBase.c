@@ -0,0 +1,62 @@
+/*
+ * timeBase.c
+ *
+ *  Created on: 17/10/2026
+ *      Description: Module keeps the system time base on wide timer 0, concatenated into a
+ *      single 64 bit timer counting up at the system clock. The count is held entirely in
+ *      hardware and TimerValueGet64() rereads the upper half until it is stable across the
+ *      lower, so a reader interrupted part way through, or an interrupt handler reading
+ *      it, always gets a consistent value with no shared state to protect. At 20 MHz the
+ *      count lasts tens of thousands of years.
+ */
+
+#include "timeBase.h"
+
+//*******************************************************************************************
+// Static variables
+//*******************************************************************************************
+static uint32_t cyclesPerUs = 1;    // Set before the timer starts, so never 0 when read
+
+//*******************************************************************************************
+// Starts the time base from zero. Call straight after the system clock is set, before any
+// module takes a timestamp.
+//*******************************************************************************************
+void
+initTimeBase(void)
+{
+    cyclesPerUs = SysCtlClockGet() / TIME_US_PER_SECOND;
+    SysCtlPeripheralEnable(TIME_BASE_PERIPH);
+    TimerConfigure(TIME_BASE_BASE, TIMER_CFG_PERIODIC_UP);
+    TimerLoadSet64(TIME_BASE_BASE, UINT64_MAX);
+    TimerEnable(TIME_BASE_BASE, TIMER_A);
+}
+
+//*******************************************************************************************
+// @return uint64_t System clock cycles since initTimeBase(), 0 before it
+//*******************************************************************************************
+uint64_t
+getTimeCycles(void)
+{
+    return TimerValueGet64(TIME_BASE_BASE);
+}
+
+//*******************************************************************************************
+// @return uint64_t Microseconds since initTimeBase(), 0 before it. Safe to call from any
+// interrupt handler, as the timer keeps the count and the two halves are read together.
+//*******************************************************************************************
+uint64_t
+getTimeUs(void)
+{
+    return timeCyclesToUs(TimerValueGet64(TIME_BASE_BASE));
+}
+
+//*******************************************************************************************
+// @param cycles A getTimeCycles() count, or a time between two of them
+//
+// @return uint64_t The same time in microseconds
+//*******************************************************************************************
+uint64_t
+timeCyclesToUs(uint64_t cycles)
+{
+    return cycles / cyclesPerUs;
+}
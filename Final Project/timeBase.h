@@ -0,0 +1,59 @@
+/*
+ * timeBase.h
+ *
+ *  Created on: 17/10/2026
+ *      Description: Header file for the system time base, a monotonic 64 bit clock every
+ *      module shares. It counts system clock cycles on a wide timer from boot, so it
+ *      resolves a fraction of a microsecond, never wraps in the life of the helicopter and
+ *      can be read from any interrupt handler.
+ */
+
+#ifndef TIMEBASE_H_
+#define TIMEBASE_H_
+
+//*******************************************************************************************
+// Header files
+//*******************************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/hw_memmap.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+
+//*******************************************************************************************
+// Constants
+//*******************************************************************************************
+#define TIME_BASE_PERIPH SYSCTL_PERIPH_WTIMER0
+#define TIME_BASE_BASE WTIMER0_BASE
+#define TIME_US_PER_SECOND 1000000
+#define TIME_US_PER_MS 1000
+
+//*******************************************************************************************
+// Starts the time base from zero. Call straight after the system clock is set, before any
+// module takes a timestamp.
+//*******************************************************************************************
+void
+initTimeBase(void);
+
+//*******************************************************************************************
+// @return uint64_t System clock cycles since initTimeBase(), 0 before it
+//*******************************************************************************************
+uint64_t
+getTimeCycles(void);
+
+//*******************************************************************************************
+// @return uint64_t Microseconds since initTimeBase(), 0 before it. Safe to call from any
+// interrupt handler, as the timer keeps the count and the two halves are read together.
+//*******************************************************************************************
+uint64_t
+getTimeUs(void);
+
+//*******************************************************************************************
+// @param cycles A getTimeCycles() count, or a time between two of them
+//
+// @return uint64_t The same time in microseconds
+//*******************************************************************************************
+uint64_t
+timeCyclesToUs(uint64_t cycles);
+
+#endif /* TIMEBASE_H_ */
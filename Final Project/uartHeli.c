@@ -9,11 +9,19 @@
 
 
 #include "uartHeli.h"
+#include "sensors.h"
 
 /********************************************************
  * Static variables
  ********************************************************/
-static char uartString[UART_VAL_LEN]; // String of length 16 for storing information to be transmitted
+static char uartLine[PROFILE_LINE_LEN]; // Line being transmitted
+static const char *uartNext; // Next character of uartLine to queue
+static coroutine_t uartCoroutine;
+static uint32_t statusLine; // Status line being sent, see formatStatusLine()
+static size_t profileReport; // Profile report sent next, see NUM_PROFILE_REPORTS
+static size_t profileLine; // Line of the profile report being sent
+static uint32_t profileUpdates; // Updates since a profile was sent
+static sensorSnapshot_t sensors; // Snapshot every status line of an update is sent from
 
 /********************************************************
  * Initialise UART peripherals and GPIO pins and UART configurations
@@ -37,6 +45,27 @@ initUart(void)
             UART_CONFIG_PAR_NONE);
     UARTFIFOEnable(UART_USB_BASE);
     UARTEnable(UART_USB_BASE);
+
+    // Commands arrive a character at a time, the timeout catches the end of a short line
+    UARTIntRegister(UART_USB_BASE, UARTIntHandler);
+    UARTIntEnable(UART_USB_BASE, UART_INT_RX | UART_INT_RT);
+}
+
+/********************************************************
+ * Posts each character received as an EVENT_UART_RX, so
+ * commands are handled in the main loop
+ ********************************************************/
+void
+UARTIntHandler(void)
+{
+    uint32_t startCycles = isrEnter(ISR_UART, ISR_LATENCY_UNKNOWN);
+    int32_t character;
+
+    UARTIntClear(UART_USB_BASE, UARTIntStatus(UART_USB_BASE, true));
+    while ((character = UARTCharGetNonBlocking(UART_USB_BASE)) != -1) {
+        postEvent(EVENT_UART_RX, 0, (uint16_t)character);
+    }
+    isrExit(ISR_UART, startCycles);
 }
 
 /********************************************************
@@ -56,36 +85,137 @@ UARTSend(char *charInputBuffer)
 }
 
 /********************************************************
- * Function to update the information displayed on the terminal by
- * regularly sending information to the terminal via UART
+ * Formats the load of every task over the last second into
+ * uartLine, in parts per thousand
  ********************************************************/
-void
-updateUART(void) {
-    // Main rotor PWM duty cycle
-    usprintf(uartString, "Main Duty %d\r\n", getAltitudePwm());
-    UARTSend(uartString);
-
-    // Tail rotor PWM duty cycle
-    usprintf(uartString, "Tail Duty %d\r\n", getYawPwm());
-    UARTSend(uartString);
+static void
+formatTaskLoads(void)
+{
+    size_t used = usnprintf(uartLine, sizeof(uartLine), "Task load");
+    size_t index;
+    for (index = 0; index < NUMTASKS && used < sizeof(uartLine); index++) {
+        used += usnprintf(uartLine + used, sizeof(uartLine) - used, " T%d %d.%1d%%",
+                          (uint32_t)index, getTaskLoad(index, LOAD_1S) / 10,
+                          getTaskLoad(index, LOAD_1S) % 10);
+    }
+    if (used < sizeof(uartLine)) {
+        usnprintf(uartLine + used, sizeof(uartLine) - used, "\r\n");
+    }
+}
 
-    // Current helicopter state
-    usprintf(uartString, "State %s\r\n", heliStateStr());
-    UARTSend(uartString);
+/********************************************************
+ * @param line Status line to format, from 0
+ *
+ * @return bool False once every status line has been formatted
+ *
+ * Formats one line of the helicopter status into uartLine
+ ********************************************************/
+static bool
+formatStatusLine(uint32_t line)
+{
+    switch (line) {
+    case 0: // Main rotor PWM duty cycle
+        usnprintf(uartLine, sizeof(uartLine), "Main Duty %d\r\n", sensors.altitudePwm);
+        break;
+    case 1: // Tail rotor PWM duty cycle
+        usnprintf(uartLine, sizeof(uartLine), "Tail Duty %d\r\n", sensors.yawPwm);
+        break;
+    case 2: // Current helicopter state
+        usnprintf(uartLine, sizeof(uartLine), "State %s\r\n", heliStateName(sensors.state));
+        break;
+    case 3: // Desired altitude
+        usnprintf(uartLine, sizeof(uartLine), "Desired Alt %4d\r\n", sensors.altitudeSetpoint);
+        break;
+    case 4: // Actual altitude
+        usnprintf(uartLine, sizeof(uartLine), "Actual Alt %4d\r\n", sensors.altitude);
+        break;
+    case 5: // Desired yaw
+        usnprintf(uartLine, sizeof(uartLine), "Desired Yaw %4d.0 \r\n", sensors.yawSetpoint);
+        break;
+    case 6: // Actual yaw
+        usnprintf(uartLine, sizeof(uartLine), "Actual Yaw %3d.%1d\r\n", sensors.yawAngle, sensors.yawDecimal);
+        break;
+    case 7: // CPU load over each window
+        usnprintf(uartLine, sizeof(uartLine), "CPU 1s %d.%1d%% 10s %d.%1d%%\r\n",
+                  getCpuLoad(LOAD_1S) / 10, getCpuLoad(LOAD_1S) % 10,
+                  getCpuLoad(LOAD_10S) / 10, getCpuLoad(LOAD_10S) % 10);
+        break;
+    case 8: // Load of each task over the last second
+        formatTaskLoads();
+        break;
+    case 9: // Time since boot
+        usnprintf(uartLine, sizeof(uartLine), "Uptime %d.%03d s\r\n",
+                  (uint32_t)(getTimeUs() / TIME_US_PER_SECOND),
+                  (uint32_t)(getTimeUs() % TIME_US_PER_SECOND / TIME_US_PER_MS));
+        break;
+    case 10: // Reply to a command, only sent once
+        if (!takeCommandReply(uartLine, sizeof(uartLine))) {
+            return false;
+        }
+        break;
+    default:
+        return false;
+    }
+    uartNext = uartLine;
+    return true;
+}
 
-    // Desired altitude
-    usprintf(uartString, "Desired Alt %4d\r\n", getAltitudeSetpoint());
-    UARTSend(uartString);
+/********************************************************
+ * @return bool True once uartLine is queued, false if the
+ * transmit FIFO filled first
+ ********************************************************/
+static bool
+queueLine(void)
+{
+    while (*uartNext) {
+        if (!UARTCharPutNonBlocking(UART_USB_BASE, *uartNext)) {
+            return false;
+        }
+        uartNext++;
+    }
+    return true;
+}
 
-    // Actual altitude
-    usprintf(uartString, "Actual Alt %4d\r\n", processAltitude());
-    UARTSend(uartString);
+/********************************************************
+ * Function to update the information displayed on the terminal by
+ * regularly sending information to the terminal via UART.
+ * Runs as a coroutine, yielding after each line and waiting
+ * for the next tick whenever the transmit FIFO is full, so it
+ * never blocks the scheduler. The status lines of an update
+ * all come from one sensor snapshot.
+ ********************************************************/
+void
+updateUART(void) {
+    COROUTINE_BEGIN(uartCoroutine);
+    getSensorSnapshot(&sensors);
+    for (statusLine = 0; formatStatusLine(statusLine); statusLine++) {
+        while (!queueLine()) {
+            COROUTINE_WAIT_TICK(uartCoroutine);
+        }
+        COROUTINE_YIELD(uartCoroutine);
+    }
 
-    // Desired yaw
-    usprintf(uartString, "Desired Yaw %4d.0 \r\n", getYawSetpoint());
-    UARTSend(uartString);
+    // One profile report every few updates keeps each update short
+    profileUpdates++;
+    if (PROFILE_UART_UPDATES > 0 && profileUpdates >= PROFILE_UART_UPDATES) {
+        profileUpdates = 0;
+        for (profileLine = 0;
+             formatProfileLine(profileReport, profileLine, uartLine, sizeof(uartLine));
+             profileLine++) {
+            uartNext = uartLine;
+            while (!queueLine()) {
+                COROUTINE_WAIT_TICK(uartCoroutine);
+            }
+            COROUTINE_YIELD(uartCoroutine);
+        }
+        profileReport = (profileReport + 1) % NUM_PROFILE_REPORTS;
+    }
 
-    // Actual yaw
-    usprintf(uartString, "Actual Yaw %3d.%1d\r\n\n", getYawOutput(), getYawDecimal());
-    UARTSend(uartString);
+    uartLine[0] = '\n';
+    uartLine[1] = '\0';
+    uartNext = uartLine;
+    while (!queueLine()) {
+        COROUTINE_WAIT_TICK(uartCoroutine);
+    }
+    COROUTINE_END(uartCoroutine);
 }
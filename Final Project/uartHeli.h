@@ -30,6 +30,12 @@
 #include "yaw.h"
 #include "altitude.h"
 #include "pwm.h"
+#include "profiler.h"
+#include "coroutine.h"
+#include "cpuLoad.h"
+#include "eventQueue.h"
+#include "commands.h"
+#include "timeBase.h"
 
 /********************************************************
  * Constants
@@ -45,9 +51,10 @@
 #define UART_USB_GPIO_PINS      UART_USB_GPIO_PIN_RX | UART_USB_GPIO_PIN_TX
 #define UART_CONFIGURATIONS UART_CONFIG_WLEN_8 | UART_CONFIG_STOP_ONE | UART_CONFIG_PAR_NONE
 #define BAUD_RATE 9600
-#define STR_LEN 16
+#define STR_LEN 32
 #define UART_VAL_LEN STR_LEN + 1
 #define MAX_UART_TICKS 120
+#define PROFILE_UART_UPDATES 4 // Updates between profile reports, 0 never sends them
 
 /********************************************************
  * Initialise UART peripherals and GPIO pins and UART configurations
@@ -55,6 +62,12 @@
 void
 initUart(void);
 
+/********************************************************
+ * Posts each character received as an EVENT_UART_RX
+ ********************************************************/
+void
+UARTIntHandler(void);
+
 /********************************************************
  * @param char
 
@@ -66,7 +79,8 @@ UARTSend(char *charInputBuffer);
 
 /********************************************************
  * Function to update the information displayed on the terminal by
- * regularly sending information to the terminal via UART
+ * regularly sending information to the terminal via UART.
+ * Yields rather than waiting on the transmit FIFO, see coroutine.h
  ********************************************************/
 void
 updateUART(void);
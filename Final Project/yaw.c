@@ -9,6 +9,7 @@
  */
 
 #include "yaw.h"
+#include "hardTier.h"
 
 //*****************************************************************************
 // Global variables
@@ -19,36 +20,40 @@ static uint8_t previousYaw = 0;
 //Raw yaw like 448 val
 static int16_t yaw = 0;
 
-//Number from -180 to 180
-static int16_t yawAngle = 0;
-
 //Desired yaw value
 static int16_t setYaw = 0;
 
-// Binary flag indicating reference yaw has been found
-static bool findReference = false;
+//*****************************************************************************
+// @return int16_t Encoder slots from the reference, -FULL_CIRCLE_SLOTS/2 to
+// FULL_CIRCLE_SLOTS/2 - 1
+//*****************************************************************************
+int16_t
+getYawCount(void)
+{
+    // A single halfword, so the encoder handler never leaves it half written
+    return yaw;
+}
 
 //*****************************************************************************
-// @return int16_t yaw angle from the static variable
+// @param count Encoder slots from the reference, as getYawCount() gives
 //
-// Converts quadrature encoding ticks to an angle
+// @return int16_t The whole degrees of the yaw angle
 //*****************************************************************************
 int16_t
-getYawOutput(void)
+yawCountToAngle(int16_t count)
 {
-    yawAngle = (yaw * FULL_CIRCLE) / FULL_CIRCLE_SLOTS;
-    return yawAngle;
+    return (count * FULL_CIRCLE) / FULL_CIRCLE_SLOTS;
 }
 
 //*****************************************************************************
-// @return int16_t yaw angle from the static variable
+// @param count Encoder slots from the reference, as getYawCount() gives
 //
-// Finds the extra decimal point of precision for the yaw angle
+// @return int16_t The tenths of a degree of the yaw angle
 //*****************************************************************************
 int16_t
-getYawDecimal(void)
+yawCountToDecimal(int16_t count)
 {
-    int16_t decimalVal = abs(((yaw * FULL_CIRCLE * FLOAT_CONVERSION)/ FULL_CIRCLE_SLOTS) % FLOAT_CONVERSION);
+    int16_t decimalVal = abs(((count * FULL_CIRCLE * FLOAT_CONVERSION)/ FULL_CIRCLE_SLOTS) % FLOAT_CONVERSION);
     return decimalVal;
 }
 
@@ -74,6 +79,8 @@ interruptSetQuadratureEncoder(void)
 void
 quadratureHandler(void)
 {
+    // Encoder edges leave no timestamp, so only the run time is profiled
+    uint32_t startCycles = isrEnter(ISR_QUADRATURE, ISR_LATENCY_UNKNOWN);
     GPIOIntClear(YAW_BASE, YAW_A_PIN | YAW_B_PIN);
     previousYaw = currentYaw;
     uint8_t yaw_a = GPIOPinRead(YAW_BASE, YAW_A_PIN);
@@ -114,6 +121,7 @@ quadratureHandler(void)
     } else if (yaw == (-FULL_CIRCLE_SLOTS/2)-1) {
         yaw = (FULL_CIRCLE_SLOTS/2)-1;
     }
+    isrExit(ISR_QUADRATURE, startCycles);
 }
 
 //*****************************************************************************
@@ -128,15 +136,16 @@ getYawSetpoint(void)
 }
 
 //*****************************************************************************
+// @param angle The true yaw angle, in whole degrees
+//
 // @return int16_t The error between the desired and the true yaw angle
 //
 // Calculates and returns the error between the desired and true yaw angle,
 // converts it to find the shortest distance to the desired angle.
 //*****************************************************************************
 int16_t
-getYawError(void) {
-    yawAngle = getYawOutput();
-    int16_t yawError = setYaw - yawAngle;
+getYawError(int16_t angle) {
+    int16_t yawError = setYaw - angle;
     if (yawError > 180) {
         yawError = (360 - yawError);
     } else if (yawError < -180) {
@@ -148,18 +157,20 @@ getYawError(void) {
 //*****************************************************************************
 // @param int16_t change in yaw angle
 //
-// Updates the set yaw based on the desired change from the current set yaw
+// Updates the set yaw based on the desired change from the current set yaw.
+// The hard tier is held off so the controller never sees it unwrapped.
 //*****************************************************************************
 void
 setYawSetpoint(int16_t change)
 {
-
+    bool wasUnlocked = lockHardTier();
     setYaw += change;
     if (setYaw > 180) {
         setYaw -= 360;
     } else if (setYaw < -180) {
         setYaw += 360;
     }
+    unlockHardTier(wasUnlocked);
 }
 
 //*****************************************************************************
@@ -185,15 +196,21 @@ interruptSetReference(void)
 void
 yawReferenceHandler(void)
 {
+    uint32_t startCycles = isrEnter(ISR_REFERENCE, ISR_LATENCY_UNKNOWN);
     GPIOIntClear(REF_BASE, REF_PIN);
     if ((getState() == TAKING_OFF) || (getState() == FINDING_REF)) {
-        uint8_t reference_read = GPIOPinRead(REF_BASE, REF_PIN);
+        // The controller preempts this handler, so it must see the yaw and its setpoint
+        // zeroed together
+        bool wasUnlocked = lockHardTier();
         yaw = 0;
         currentYaw = 0;
         previousYaw = 0;
         setYaw = 0;
-        findReference = true;
+        unlockHardTier(wasUnlocked);
+        // The yaw is zeroed here so no encoder edge is counted against the old zero
+        postEvent(EVENT_REFERENCE, 0, 0);
     }
+    isrExit(ISR_REFERENCE, startCycles);
 }
 
 //*****************************************************************************
@@ -205,22 +222,10 @@ resetYaw(void) {
 }
 
 //*****************************************************************************
-// Resets the reference interrupt handler boolean
+// Gets the helicopter to do a 360 turn until the reference point is found,
+// which posts an EVENT_REFERENCE.
 //*****************************************************************************
 void
-updateReference(void) {
-    findReference = false;
-}
-
-//*****************************************************************************
-// @return bool Returns true once the reference interrupt is called
-//
-// Gets the helicopter to do a 360 turn until the reference point is found.
-//*****************************************************************************
-bool
 fullRevolution(void) {
-    if (!findReference) {
-        setYawPwm(REVOLUITON_PWM);
-    }
-    return findReference;
+    setYawPwm(REVOLUITON_PWM);
 }
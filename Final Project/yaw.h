@@ -27,6 +27,8 @@
 #include "switches.h"
 #include "states.h"
 #include "pwm.h"
+#include "profiler.h"
+#include "eventQueue.h"
 
 //*****************************************************************************
 // Constants
@@ -53,20 +55,27 @@ int16_t
 getYawSetpoint(void);
 
 //*****************************************************************************
-// @return int16_t yaw angle from the static variable
+// @return int16_t Encoder slots from the reference, -FULL_CIRCLE_SLOTS/2 to
+// FULL_CIRCLE_SLOTS/2 - 1
+//*****************************************************************************
+int16_t
+getYawCount(void);
+
+//*****************************************************************************
+// @param count Encoder slots from the reference, as getYawCount() gives
 //
-// Converts quadrature encoding ticks to an angle
+// @return int16_t The whole degrees of the yaw angle
 //*****************************************************************************
 int16_t
-getYawOutput(void);
+yawCountToAngle(int16_t count);
 
 //*****************************************************************************
-// @return int16_t yaw angle from the static variable
+// @param count Encoder slots from the reference, as getYawCount() gives
 //
-// Finds the extra decimal point of precision for the yaw angle
+// @return int16_t The tenths of a degree of the yaw angle
 //*****************************************************************************
 int16_t
-getYawDecimal(void);
+yawCountToDecimal(int16_t count);
 
 //*****************************************************************************
 // Sets the interrupt for the quadrature encoder for both edges of both encoder pins
@@ -81,13 +90,15 @@ void
 quadratureHandler(void);
 
 //*****************************************************************************
+// @param angle The true yaw angle, in whole degrees
+//
 // @return int16_t The error between the desired and the true yaw angle
 //
 // Calculates and returns the error between the desired and true yaw angle,
 // converts it to find the shortest distance to the desired angle.
 //*****************************************************************************
 int16_t
-getYawError(void);
+getYawError(int16_t angle);
 
 //*****************************************************************************
 // @param int16_t change in yaw angle
@@ -117,22 +128,15 @@ void
 resetYaw(void);
 
 //*****************************************************************************
-// Resets the reference interrupt handler boolean
+// Gets the helicopter to do a 360 turn until the reference point is found,
+// which posts an EVENT_REFERENCE.
 //*****************************************************************************
 void
-updateReference(void);
-
-//*****************************************************************************
-// @return bool Returns true once the reference interrupt is called
-//
-// Gets the helicopter to do a 360 turn until the reference point is found.
-//*****************************************************************************
-bool
 fullRevolution(void);
 
 //*****************************************************************************
 // Handles the interrupt called by the reference pin. Resets the yaw angles to 0,
-// indicating the 0 degree point.
+// indicating the 0 degree point, and posts an EVENT_REFERENCE.
 //*****************************************************************************
 void
 yawReferenceHandler(void);